@@ -0,0 +1,163 @@
+//
+//  CRTP.h
+//
+//  Modified by 罗铮 on 04/10/16.
+//  https://segmentfault.com/a/1190000003901666
+//
+//  Operator policies mixed into cmplx, vec and mat through CRTP. The
+//  policies are empty and reach the derived object with static_cast, so
+//  cmplx<double> is laid out exactly like double[2] and vec<cmplx<T>, N>
+//  like an interleaved array of N complex numbers.
+
+#ifndef CRTP_H
+#define CRTP_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <utility>
+
+template<typename T>
+struct add_impl {
+    static T add(T l, const T& r) {
+        typedef decltype(*r.begin()) val;
+        std::transform(r.begin(), r.end(), l.begin(), l.begin(),
+            [](const val& vl, const val& rl) { return vl + rl; });
+        return l;
+    }
+};
+
+template<typename Base, template<typename> class Impl>
+struct add_ops {
+    template<typename T1>
+    auto operator+(const T1& other) const ->
+            decltype(Impl<Base>::add(std::declval<const Base&>(), other)) {
+        return Impl<Base>::add(static_cast<const Base&>(*this), other);
+    }
+
+    template<typename T1>
+    Base& operator+=(const T1& other) {
+        return static_cast<Base&>(*this) = operator+(other);
+    }
+};
+
+// element by element; complex numbers multiply as complex numbers
+template<typename T>
+struct mul_impl {
+    static T mul(T l, const T& r) {
+        typedef decltype(*r.begin()) val;
+        std::transform(r.begin(), r.end(), l.begin(), l.begin(),
+            [](const val& vl, const val& rl) { return vl * rl; });
+        return l;
+    }
+};
+
+template<typename T> struct cmplx;
+template<typename T>
+struct mul_impl<cmplx<T>> {
+    static cmplx<T> mul(const cmplx<T>& l, const cmplx<T>& r) {
+        return cmplx<T>{ l[0] * r[0] - l[1] * r[1], l[0] * r[1] + l[1] * r[0] };
+    }
+};
+
+template<typename Base, template<typename> class Impl>
+struct mul_ops {
+    template<typename T1>
+    auto operator*(const T1& other) const ->
+            decltype(Impl<Base>::mul(std::declval<const Base&>(), other)) {
+        return Impl<Base>::mul(static_cast<const Base&>(*this), other);
+    }
+
+    template<typename T1>
+    Base& operator*=(const T1& other) {
+        return static_cast<Base&>(*this) = operator*(other);
+    }
+};
+
+template<typename T>
+struct fmt_impl {
+    static void fmt(std::ostream& os, const T& t) {
+        typedef decltype(*t.begin()) val;
+        os << "[ ";
+        std::for_each(t.begin(), t.end(), [&](const val& v) {
+            os << v << ' ';
+        });
+        os << "]";
+    }
+};
+
+template<typename T>
+struct fmt_impl<cmplx<T>> {
+    static void fmt(std::ostream& os, const cmplx<T>& c) {
+        os << c[0] << "+" << c[1] << "i";
+    }
+};
+
+template<typename Base, template<typename> class Impl>
+struct fmt_ops { };
+
+template<typename Base, template<typename> class Impl>
+inline std::ostream& operator<<(std::ostream& os, const fmt_ops<Base, Impl>& ops) {
+    Impl<Base>::fmt(os, static_cast<const Base&>(ops));
+    return os;
+}
+
+////////////////////////////////////////////////////////////
+template<typename T>
+struct cmplx : public std::array<T, 2>,
+        public add_ops<cmplx<T>, add_impl>,
+        public mul_ops<cmplx<T>, mul_impl>,
+        public fmt_ops<cmplx<T>, fmt_impl>
+{
+    typedef std::array<T, 2> array_t;
+
+    cmplx() { }
+    cmplx(std::initializer_list<T> l)
+        { std::copy_n(l.begin(), 2, this->begin()); }
+};
+
+template<typename T>
+inline cmplx<T> conj(const cmplx<T>& c) {
+    return cmplx<T>{ c[0], -c[1] };
+}
+
+// squared magnitude
+template<typename T>
+inline T norm(const cmplx<T>& c) {
+    return c[0] * c[0] + c[1] * c[1];
+}
+
+template<typename T>
+inline T abs(const cmplx<T>& c) {
+    return std::sqrt(norm(c));
+}
+
+template<typename T, size_t N>
+struct vec : public std::array<T, N>,
+        public add_ops<vec<T, N>, add_impl>,
+        public mul_ops<vec<T, N>, mul_impl>,
+        public fmt_ops<vec<T, N>, fmt_impl>
+{
+    typedef std::array<T, N> array_t;
+
+    vec() { }
+    vec(std::initializer_list<T> l)
+        { std::copy_n(l.begin(), N, this->begin()); }
+};
+
+template<typename T, size_t N, size_t M>
+struct mat : public std::array<vec<T, N>, M>,
+        public add_ops<mat<T, N, M>, add_impl>,
+        public fmt_ops<mat<T, N, M>, fmt_impl>
+{
+    typedef std::array<vec<T, N>, M> array_t;
+
+    mat() { }
+    mat(std::initializer_list<vec<T, N>> l)
+        { std::copy_n(l.begin(), M, this->begin()); }
+};
+
+#endif
@@ -0,0 +1,377 @@
+//
+//  bench.h
+//
+//  Created on 10/19/26.
+//  http://man7.org/linux/man-pages/man2/perf_event_open.2.html
+//  https://github.com/google/benchmark/blob/main/docs/user_guide.md
+//
+//  Micro-benchmark harness shared by the `make bench` builds. Each
+//  benchmark is warmed up, calibrated to a minimum sample time, sampled
+//  repeatedly, and summarized after dropping samples more than three
+//  (scaled) median absolute deviations from the median. Hardware
+//  counters come from perf_event_open when the kernel allows it.
+//
+//  Command line of a benchmark program:
+//    --json=FILE       write the results as JSON
+//    --baseline=FILE   compare medians against an earlier JSON file
+//    --threshold=PCT   exit with 1 if a median regressed by more than PCT
+//    --filter=TEXT     only run benchmarks whose name contains TEXT
+//    --samples=N       samples per benchmark (default 30)
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+// Makes the compiler assume value is read, and memory written, here.
+template<typename T>
+inline void do_not_optimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+// Swallows output, for timing code that prints to std::cout.
+struct null_buf : std::streambuf {
+    int overflow(int c) { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) { return n; }
+};
+
+////////////////////////////////////////////////////////////
+// Hardware counters
+struct counters {
+    counters() : valid(false), cycles(0), instructions(0),
+        cache_misses(0), branch_misses(0) { }
+    bool valid;
+    double cycles, instructions, cache_misses, branch_misses;
+};
+
+#if defined(__linux__)
+class perf_group {
+public:
+    perf_group() : m_leader(-1) {
+        const uint64_t events[4] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+        };
+        for (int i = 0; i < 4; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = events[i];
+            attr.disabled = i == 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            int fd = int(syscall(__NR_perf_event_open, &attr, 0, -1,
+                                 m_leader, 0));
+            if (fd < 0) {
+                close_all();
+                return;
+            }
+            if (i == 0)
+                m_leader = fd;
+            m_fds.push_back(fd);
+        }
+    }
+    ~perf_group() { close_all(); }
+
+    bool available() const { return m_leader >= 0; }
+
+    void start() {
+        ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    // counts since start(), divided by ops
+    counters stop(double ops) {
+        ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        uint64_t buf[1 + 4] = { 0 };
+        counters c;
+        if (read(m_leader, buf, sizeof(buf)) == ssize_t(sizeof(buf)) &&
+                buf[0] == 4) {
+            c.valid = true;
+            c.cycles = buf[1] / ops;
+            c.instructions = buf[2] / ops;
+            c.cache_misses = buf[3] / ops;
+            c.branch_misses = buf[4] / ops;
+        }
+        return c;
+    }
+
+private:
+    void close_all() {
+        for (int fd : m_fds)
+            close(fd);
+        m_fds.clear();
+        m_leader = -1;
+    }
+
+    int m_leader;
+    std::vector<int> m_fds;
+};
+#else
+class perf_group {
+public:
+    bool available() const { return false; }
+    void start() { }
+    counters stop(double) { return counters(); }
+};
+#endif
+
+////////////////////////////////////////////////////////////
+struct result {
+    std::string name;
+    uint64_t iterations;  // calls per sample
+    size_t samples;
+    size_t kept;
+    double median_ns, mean_ns, min_ns, stddev_ns;
+    counters hw;
+};
+
+inline double median_of(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+// Reads the median_ns of every benchmark in a file written by suite.
+inline std::map<std::string, double> read_baseline(const std::string& path) {
+    std::map<std::string, double> medians;
+    std::ifstream in(path.c_str());
+    std::stringstream ss;
+    ss << in.rdbuf();
+    const std::string text = ss.str();
+    const std::string name_key = "\"name\": \"", median_key = "\"median_ns\": ";
+    for (size_t pos = text.find(name_key); pos != std::string::npos;
+            pos = text.find(name_key, pos)) {
+        pos += name_key.size();
+        size_t end = text.find('"', pos);
+        size_t m = text.find(median_key, end);
+        if (end == std::string::npos || m == std::string::npos)
+            break;
+        medians[text.substr(pos, end - pos)] =
+            std::strtod(text.c_str() + m + median_key.size(), nullptr);
+    }
+    return medians;
+}
+
+class suite {
+public:
+    suite(const std::string& program, int argc, char* argv[])
+        : m_program(program), m_out(std::cout.rdbuf()), m_samples(30),
+          m_min_sample_ns(2e6), m_warmup_ns(2e7), m_threshold(-1) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.compare(0, 7, "--json=") == 0)
+                m_json = arg.substr(7);
+            else if (arg.compare(0, 11, "--baseline=") == 0)
+                m_baseline = arg.substr(11);
+            else if (arg.compare(0, 12, "--threshold=") == 0)
+                m_threshold = std::atof(arg.c_str() + 12);
+            else if (arg.compare(0, 9, "--filter=") == 0)
+                m_filter = arg.substr(9);
+            else if (arg.compare(0, 10, "--samples=") == 0)
+                m_samples = std::max(3, std::atoi(arg.c_str() + 10));
+            else
+                std::cerr << program << ": ignoring " << arg << '\n';
+        }
+        m_out << "== " << program
+                  << (m_perf.available() ? "" : " (hardware counters unavailable)")
+                  << " ==\n";
+    }
+
+    template<typename F>
+    void run(const std::string& name, F f) {
+        if (!m_filter.empty() && name.find(m_filter) == std::string::npos)
+            return;
+
+        // warm up caches, branch predictors and the CPU clock
+        double spent = 0;
+        uint64_t iters = 1;
+        while (spent < m_warmup_ns) {
+            spent += time_batch(f, iters);
+            if (spent * 4 < m_warmup_ns)
+                iters *= 2;
+        }
+        // calibrate so that one sample takes at least m_min_sample_ns
+        iters = 1;
+        while (time_batch(f, iters) < m_min_sample_ns && iters < (1ull << 40))
+            iters *= 2;
+
+        std::vector<double> ns(m_samples);
+        if (m_perf.available())
+            m_perf.start();
+        for (size_t s = 0; s < ns.size(); ++s)
+            ns[s] = time_batch(f, iters) / iters;
+        result r;
+        r.hw = m_perf.available()
+            ? m_perf.stop(double(iters) * ns.size()) : counters();
+
+        // drop samples further than 3 scaled MADs from the median
+        double med = median_of(ns);
+        std::vector<double> dev;
+        for (double x : ns)
+            dev.push_back(std::fabs(x - med));
+        double limit = 3 * 1.4826 * median_of(dev);
+        std::vector<double> kept;
+        for (double x : ns)
+            if (std::fabs(x - med) <= limit)
+                kept.push_back(x);
+
+        double sum = 0, sq = 0;
+        for (double x : kept)
+            sum += x;
+        double mean = sum / kept.size();
+        for (double x : kept)
+            sq += (x - mean) * (x - mean);
+
+        r.name = name;
+        r.iterations = iters;
+        r.samples = ns.size();
+        r.kept = kept.size();
+        r.median_ns = median_of(kept);
+        r.mean_ns = mean;
+        r.min_ns = *std::min_element(kept.begin(), kept.end());
+        r.stddev_ns = kept.size() > 1 ? std::sqrt(sq / (kept.size() - 1)) : 0;
+        print(r);
+        m_results.push_back(r);
+    }
+
+    // Writes JSON, compares against the baseline; returns main's status.
+    int finish() {
+        if (!m_json.empty())
+            write_json();
+        if (m_baseline.empty())
+            return 0;
+        std::map<std::string, double> base = read_baseline(m_baseline);
+        if (base.empty()) {
+            m_out << "no baseline results in " << m_baseline << '\n';
+            return 0;
+        }
+        int status = 0;
+        m_out << "-- against " << m_baseline << " --\n";
+        for (const result& r : m_results) {
+            std::map<std::string, double>::const_iterator b = base.find(r.name);
+            if (b == base.end()) {
+                m_out << std::setw(28) << std::left << r.name << std::right
+                          << "  (new)\n";
+                continue;
+            }
+            double change = (r.median_ns / b->second - 1) * 100;
+            bool regressed = m_threshold >= 0 && change > m_threshold;
+            status |= regressed;
+            m_out << std::setw(28) << std::left << r.name << std::right
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(12) << b->second << " ns -> "
+                      << std::setw(10) << r.median_ns << " ns  "
+                      << std::showpos << std::setprecision(1) << change
+                      << std::noshowpos << "%"
+                      << (regressed ? "  REGRESSION" : "") << '\n';
+        }
+        return status;
+    }
+
+private:
+    template<typename F>
+    static double time_batch(F& f, uint64_t iters) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iters; ++i) {
+            f();
+            clobber_memory();
+        }
+        std::chrono::duration<double, std::nano> ns =
+            std::chrono::steady_clock::now() - start;
+        return ns.count();
+    }
+
+    void print(const result& r) const {
+        m_out << std::setw(28) << std::left << r.name << std::right
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(12) << r.median_ns << " ns"
+                  << "  +/-" << std::setw(8) << r.stddev_ns
+                  << "  (" << r.kept << "/" << r.samples << " samples x "
+                  << r.iterations << ")";
+        if (r.hw.valid)
+            m_out << std::setprecision(1)
+                      << "  cyc " << r.hw.cycles << "  ins " << r.hw.instructions
+                      << "  cache-miss " << r.hw.cache_misses
+                      << "  br-miss " << r.hw.branch_misses;
+        m_out << '\n';
+    }
+
+    static std::string json_number(bool valid, double v) {
+        if (!valid)
+            return "null";
+        std::ostringstream os;
+        os << std::setprecision(6) << v;
+        return os.str();
+    }
+
+    void write_json() const {
+        std::ofstream out(m_json.c_str());
+        out << "{\n  \"program\": \"" << m_program << "\",\n"
+            << "  \"benchmarks\": [\n";
+        for (size_t i = 0; i < m_results.size(); ++i) {
+            const result& r = m_results[i];
+            out << "    {\"name\": \"" << r.name << "\""
+                << ", \"iterations\": " << r.iterations
+                << ", \"samples\": " << r.samples
+                << ", \"kept\": " << r.kept
+                << ", \"median_ns\": " << json_number(true, r.median_ns)
+                << ", \"mean_ns\": " << json_number(true, r.mean_ns)
+                << ", \"min_ns\": " << json_number(true, r.min_ns)
+                << ", \"stddev_ns\": " << json_number(true, r.stddev_ns)
+                << ", \"cycles\": " << json_number(r.hw.valid, r.hw.cycles)
+                << ", \"instructions\": "
+                << json_number(r.hw.valid, r.hw.instructions)
+                << ", \"cache_misses\": "
+                << json_number(r.hw.valid, r.hw.cache_misses)
+                << ", \"branch_misses\": "
+                << json_number(r.hw.valid, r.hw.branch_misses)
+                << "}" << (i + 1 < m_results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+        if (!out)
+            std::cerr << m_program << ": cannot write " << m_json << '\n';
+    }
+
+    std::string m_program;
+    // keeps reporting even while a benchmark redirects std::cout
+    mutable std::ostream m_out;
+    int m_samples;
+    double m_min_sample_ns;
+    double m_warmup_ns;
+    double m_threshold;
+    std::string m_json, m_baseline, m_filter;
+    perf_group m_perf;
+    std::vector<result> m_results;
+};
+
+} // namespace bench
+
+#endif
@@ -0,0 +1,126 @@
+//
+//  big_integer.cpp
+//
+//  Created on 10/19/26.
+//  https://gmplib.org/manual/Factorial-Algorithm
+//
+//  Computes 100000! two ways with big_integer.h and times printing it.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <random>
+#include "big_integer.h"
+
+using namespace std;
+
+// C++11 constexpr functions use recursion rather than iteration
+constexpr int factorial(int n)
+{
+    return n <= 1? 1 : (n * factorial(n - 1));
+}
+
+// Multiplies the running product in place, packing small factors into
+// one limb-sized multiplier so the storage is reused across iterations.
+big_integer factorial_accumulate(unsigned n) {
+    big_integer r(1);
+    r.reserve(n * 6 / big_integer::base_digits + 1);
+    uint64_t pack = 1;
+    for (unsigned i = 2; i <= n; ++i) {
+        if (pack * i > 0xffffffffull) {
+            r.mul_small(uint32_t(pack));
+            pack = 1;
+        }
+        pack *= i;
+    }
+    return r.mul_small(uint32_t(pack));
+}
+
+// Product of [lo, hi): balanced operands keep Karatsuba busy.
+big_integer product(unsigned lo, unsigned hi) {
+    if (hi - lo <= 8) {
+        big_integer r(1);
+        for (unsigned i = lo; i < hi; ++i)
+            r.mul_small(i);
+        return r;
+    }
+    unsigned mid = lo + (hi - lo) / 2;
+    return product(lo, mid) * product(mid, hi);
+}
+
+big_integer factorial_tree(unsigned n) {
+    return n < 2 ? big_integer(1) : product(2, n + 1);
+}
+
+template<typename F>
+double time_ms(F f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    chrono::duration<double, milli> ms = chrono::steady_clock::now() - start;
+    return ms.count();
+}
+
+big_integer random_big(mt19937& rng, size_t limbs) {
+    string s(limbs * big_integer::base_digits, '0');
+    s[0] = '1';
+    for (size_t i = 1; i < s.size(); ++i)
+        s[i] = char('0' + rng() % 10);
+    return big_integer(s);
+}
+
+int main()
+{
+    // 12! is the last factorial that fits in an int
+    cout << "12! = " << factorial(12) << endl;
+    cout << "13! = " << factorial_tree(13) << endl;
+    cout << "30! = " << factorial_tree(30) << endl;
+
+    big_integer a("-123456789012345678901234567890");
+    big_integer b("987654321098765432109876543210");
+    cout << "a + b = " << a + b << endl;
+    cout << "a - b = " << a - b << endl;
+    cout << "a * b = " << a * b << endl;
+
+    /////////////////////////////////////////////////////////
+    // Crossover between schoolbook and Karatsuba
+    mt19937 rng(42);
+    cout << setw(8) << "limbs" << setw(14) << "school us"
+         << setw(14) << "multiply us" << endl;
+    const size_t sizes[] = { 16, 32, 48, 64, 128, 512, 2048 };
+    for (size_t n : sizes) {
+        big_integer x = random_big(rng, n), y = random_big(rng, n);
+        big_integer r1, r2;
+        int reps = int(2000000 / (n * n)) + 3;
+        double t1 = time_ms([&] {
+            for (int i = 0; i < reps; ++i)
+                big_integer::multiply_schoolbook(r1, x, y);
+        });
+        double t2 = time_ms([&] {
+            for (int i = 0; i < reps; ++i)
+                big_integer::multiply(r2, x, y);
+        });
+        cout << setw(8) << n << fixed << setprecision(2)
+             << setw(14) << t1 * 1000 / reps << setw(14) << t2 * 1000 / reps
+             << (r1 == r2 ? "" : "  MISMATCH") << endl;
+    }
+
+    /////////////////////////////////////////////////////////
+    const unsigned n = 100000;
+    big_integer f1, f2;
+    string digits;
+    double t_acc = time_ms([&] { f1 = factorial_accumulate(n); });
+    double t_tree = time_ms([&] { f2 = factorial_tree(n); });
+    double t_print = time_ms([&] { digits = f2.to_string(); });
+    big_integer parsed;
+    double t_parse = time_ms([&] { parsed.assign(digits); });
+
+    cout << n << "! has " << digits.size() << " digits: "
+         << digits.substr(0, 20) << "..." << endl;
+    cout << "accumulator loop: " << t_acc << " ms" << endl;
+    cout << "product tree:     " << t_tree << " ms"
+         << (f1 == f2 ? "" : "  MISMATCH") << endl;
+    cout << "print:            " << t_print << " ms" << endl;
+    cout << "parse:            " << t_parse << " ms"
+         << (parsed == f2 ? "" : "  MISMATCH") << endl;
+}
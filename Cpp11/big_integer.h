@@ -0,0 +1,371 @@
+//
+//  big_integer.h
+//
+//  Created on 10/19/26.
+//  https://gmplib.org/manual/Karatsuba-Multiplication
+//  https://cp-algorithms.com/algebra/big-integer.html
+//
+//  Arbitrary-precision signed integer. The magnitude is a contiguous
+//  array of base 10^9 limbs, least significant first, so decimal parsing
+//  and printing are linear and need no big divisions.
+
+#ifndef BIG_INTEGER_H
+#define BIG_INTEGER_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "integral_trait.h"
+
+class big_integer {
+public:
+    typedef uint32_t limb_t;
+    static const limb_t base = 1000000000;
+    static const int base_digits = 9;
+    // operand size in limbs above which Karatsuba beats schoolbook;
+    // measured with big_integer.cpp
+    static const size_t karatsuba_threshold = 40;
+
+    big_integer() : m_negative(false) { }
+
+    big_integer(long long v) : m_negative(v < 0) {
+        unsigned long long u = v < 0 ? 0ull - (unsigned long long)v : v;
+        for (; u; u /= base)
+            m_limbs.push_back(limb_t(u % base));
+    }
+
+    big_integer(const std::string& s) : m_negative(false) { assign(s); }
+
+    // Parses an optionally signed decimal string, reusing the storage.
+    void assign(const std::string& s) {
+        size_t begin = s.size() > 0 && (s[0] == '-' || s[0] == '+');
+        if (begin == s.size())
+            throw std::invalid_argument("big_integer: no digits");
+        m_limbs.clear();
+        m_limbs.reserve((s.size() - begin) / base_digits + 1);
+        for (size_t end = s.size(); end > begin; ) {
+            size_t start = end - begin > size_t(base_digits)
+                ? end - base_digits : begin;
+            limb_t limb = 0;
+            for (size_t i = start; i < end; ++i) {
+                if (s[i] < '0' || s[i] > '9')
+                    throw std::invalid_argument("big_integer: " + s);
+                limb = limb * 10 + limb_t(s[i] - '0');
+            }
+            m_limbs.push_back(limb);
+            end = start;
+        }
+        m_negative = s[0] == '-';
+        trim();
+    }
+
+    std::string to_string() const {
+        if (m_limbs.empty())
+            return "0";
+        std::string s(m_negative + base_digits * m_limbs.size(), '0');
+        char* p = &s[0];
+        if (m_negative)
+            *p++ = '-';
+        p += std::sprintf(p, "%u", m_limbs.back());
+        for (size_t i = m_limbs.size() - 1; i-- > 0; p += base_digits)
+            for (int d = base_digits - 1, v = m_limbs[i]; d >= 0; --d, v /= 10)
+                p[d] = char('0' + v % 10);
+        s.resize(p - s.data());
+        return s;
+    }
+
+    bool is_zero() const { return m_limbs.empty(); }
+    bool is_negative() const { return m_negative; }
+    size_t limbs() const { return m_limbs.size(); }
+    void reserve(size_t limbs) { m_limbs.reserve(limbs); }
+
+    void swap(big_integer& other) {
+        m_limbs.swap(other.m_limbs);
+        std::swap(m_negative, other.m_negative);
+    }
+
+    // In-place accumulator operations; they only allocate when the
+    // result outgrows the current capacity.
+    big_integer& mul_small(limb_t m) {
+        if (m == 0) {
+            m_limbs.clear();
+            m_negative = false;
+            return *this;
+        }
+        uint64_t carry = 0;
+        for (size_t i = 0; i < m_limbs.size(); ++i) {
+            uint64_t cur = uint64_t(m_limbs[i]) * m + carry;
+            m_limbs[i] = limb_t(cur % base);
+            carry = cur / base;
+        }
+        for (; carry; carry /= base)
+            m_limbs.push_back(limb_t(carry % base));
+        return *this;
+    }
+
+    big_integer& operator+=(const big_integer& other) {
+        if (m_negative == other.m_negative) {
+            add_magnitude(other.m_limbs);
+        } else if (compare_magnitude(m_limbs, other.m_limbs) >= 0) {
+            sub_magnitude(other.m_limbs);
+        } else {
+            std::vector<limb_t> tmp(other.m_limbs);
+            sub_limbs(&tmp[0], tmp.size(), m_limbs.data(), m_limbs.size());
+            m_limbs.swap(tmp);
+            m_negative = other.m_negative;
+        }
+        trim();
+        return *this;
+    }
+
+    big_integer& operator-=(const big_integer& other) {
+        // flipping our sign would flip other's too
+        if (&other == this) {
+            m_limbs.clear();
+            m_negative = false;
+            return *this;
+        }
+        m_negative = !m_negative;
+        *this += other;
+        if (!m_limbs.empty())
+            m_negative = !m_negative;
+        return *this;
+    }
+
+    big_integer& operator*=(const big_integer& other) {
+        big_integer r;
+        multiply(r, *this, other);
+        swap(r);
+        return *this;
+    }
+
+    // out = a * b, reusing out's storage; out may not alias a or b.
+    static void multiply(big_integer& out, const big_integer& a,
+                         const big_integer& b) {
+        assert(&out != &a && &out != &b);
+        out.m_limbs.assign(a.m_limbs.size() + b.m_limbs.size(), 0);
+        out.m_negative = a.m_negative != b.m_negative;
+        if (a.m_limbs.empty() || b.m_limbs.empty()) {
+            out.m_limbs.clear();
+            out.m_negative = false;
+            return;
+        }
+        std::vector<limb_t> scratch(
+            4 * (a.m_limbs.size() + b.m_limbs.size()) + 256);
+        size_t top = 0;
+        mul(a.m_limbs.data(), a.m_limbs.size(),
+            b.m_limbs.data(), b.m_limbs.size(), &out.m_limbs[0],
+            scratch, top);
+        out.trim();
+    }
+
+    // Schoolbook product regardless of size, for threshold tuning.
+    static void multiply_schoolbook(big_integer& out, const big_integer& a,
+                                    const big_integer& b) {
+        out.m_limbs.assign(a.m_limbs.size() + b.m_limbs.size(), 0);
+        out.m_negative = a.m_negative != b.m_negative;
+        if (!a.m_limbs.empty() && !b.m_limbs.empty())
+            mul_school(a.m_limbs.data(), a.m_limbs.size(),
+                       b.m_limbs.data(), b.m_limbs.size(), &out.m_limbs[0]);
+        out.trim();
+    }
+
+    friend big_integer operator-(big_integer a) {
+        if (!a.m_limbs.empty())
+            a.m_negative = !a.m_negative;
+        return a;
+    }
+    friend big_integer operator+(big_integer a, const big_integer& b)
+        { return a += b; }
+    friend big_integer operator-(big_integer a, const big_integer& b)
+        { return a -= b; }
+    friend big_integer operator*(const big_integer& a, const big_integer& b)
+        { big_integer r; multiply(r, a, b); return r; }
+
+    friend bool operator==(const big_integer& a, const big_integer& b)
+        { return a.m_negative == b.m_negative && a.m_limbs == b.m_limbs; }
+    friend bool operator!=(const big_integer& a, const big_integer& b)
+        { return !(a == b); }
+    friend bool operator<(const big_integer& a, const big_integer& b) {
+        if (a.m_negative != b.m_negative)
+            return a.m_negative;
+        int c = compare_magnitude(a.m_limbs, b.m_limbs);
+        return a.m_negative ? c > 0 : c < 0;
+    }
+    friend bool operator>(const big_integer& a, const big_integer& b)
+        { return b < a; }
+    friend bool operator<=(const big_integer& a, const big_integer& b)
+        { return !(b < a); }
+    friend bool operator>=(const big_integer& a, const big_integer& b)
+        { return !(a < b); }
+
+    friend std::ostream& operator<<(std::ostream& os, const big_integer& b)
+        { return os << b.to_string(); }
+
+    // the limbs folded together; hash_of in hash_map.h finds it by
+    // argument-dependent lookup. Zero is never negative, see trim().
+    friend uint64_t hash_value(const big_integer& b) {
+        uint64_t h = b.m_negative;
+        for (limb_t limb : b.m_limbs)
+            h = (h ^ limb) * 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 32);
+    }
+
+private:
+    void trim() {
+        while (!m_limbs.empty() && m_limbs.back() == 0)
+            m_limbs.pop_back();
+        if (m_limbs.empty())
+            m_negative = false;
+    }
+
+    static int compare_magnitude(const std::vector<limb_t>& a,
+                                 const std::vector<limb_t>& b) {
+        if (a.size() != b.size())
+            return a.size() < b.size() ? -1 : 1;
+        for (size_t i = a.size(); i-- > 0; )
+            if (a[i] != b[i])
+                return a[i] < b[i] ? -1 : 1;
+        return 0;
+    }
+
+    void add_magnitude(const std::vector<limb_t>& other) {
+        if (m_limbs.size() < other.size())
+            m_limbs.resize(other.size(), 0);
+        m_limbs.push_back(0);
+        add_limbs(&m_limbs[0], m_limbs.size(), other.data(), other.size());
+    }
+
+    // requires |*this| >= |other|
+    void sub_magnitude(const std::vector<limb_t>& other) {
+        sub_limbs(&m_limbs[0], m_limbs.size(), other.data(), other.size());
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Limb-array kernels. r must be long enough to absorb the carry.
+    static void add_limbs(limb_t* r, size_t rn, const limb_t* a, size_t an) {
+        limb_t carry = 0;
+        size_t i = 0;
+        for (; i < an; ++i) {
+            limb_t cur = r[i] + a[i] + carry;
+            carry = cur >= base;
+            r[i] = carry ? cur - base : cur;
+        }
+        for (; carry && i < rn; ++i) {
+            carry = ++r[i] == base;
+            if (carry)
+                r[i] = 0;
+        }
+        assert(!carry);
+    }
+
+    // requires r >= a
+    static void sub_limbs(limb_t* r, size_t rn, const limb_t* a, size_t an) {
+        limb_t borrow = 0;
+        size_t i = 0;
+        for (; i < an; ++i) {
+            limb_t sub = a[i] + borrow;
+            borrow = r[i] < sub;
+            r[i] = borrow ? r[i] + base - sub : r[i] - sub;
+        }
+        for (; borrow && i < rn; ++i) {
+            borrow = r[i] == 0;
+            r[i] = borrow ? base - 1 : r[i] - 1;
+        }
+        assert(!borrow);
+    }
+
+    // r[0, an + bn) must be zero on entry.
+    static void mul_school(const limb_t* a, size_t an,
+                           const limb_t* b, size_t bn, limb_t* r) {
+        for (size_t i = 0; i < an; ++i) {
+            uint64_t carry = 0;
+            uint64_t ai = a[i];
+            for (size_t j = 0; j < bn; ++j) {
+                uint64_t cur = r[i + j] + ai * b[j] + carry;
+                r[i + j] = limb_t(cur % base);
+                carry = cur / base;
+            }
+            r[i + bn] = limb_t(carry);
+        }
+    }
+
+    // Stack-like scratch space shared by the whole multiplication.
+    static limb_t* take(std::vector<limb_t>& scratch, size_t& top, size_t n) {
+        assert(top + n <= scratch.size());
+        limb_t* p = &scratch[top];
+        std::fill(p, p + n, 0);
+        top += n;
+        return p;
+    }
+
+    // r[0, an + bn) must be zero on entry.
+    static void mul(const limb_t* a, size_t an, const limb_t* b, size_t bn,
+                    limb_t* r, std::vector<limb_t>& scratch, size_t& top) {
+        if (an < bn) {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+        if (bn < karatsuba_threshold) {
+            mul_school(a, an, b, bn, r);
+            return;
+        }
+        size_t mark = top;
+        if (an >= 2 * bn) {
+            // unbalanced: multiply b by bn-sized slices of a
+            limb_t* t = take(scratch, top, 2 * bn);
+            for (size_t off = 0; off < an; off += bn) {
+                size_t n = std::min(bn, an - off);
+                std::fill(t, t + n + bn, 0);
+                mul(a + off, n, b, bn, t, scratch, top);
+                add_limbs(r + off, an + bn - off, t, n + bn);
+            }
+            top = mark;
+            return;
+        }
+
+        // a = a1 B^m + a0, b = b1 B^m + b0 with m < bn <= an
+        size_t m = an / 2;
+        mul(a, m, b, m, r, scratch, top);                      // z0
+        mul(a + m, an - m, b + m, bn - m, r + 2 * m, scratch, top); // z2
+
+        size_t sn = an - m + 1;
+        limb_t* sa = take(scratch, top, sn);
+        limb_t* sb = take(scratch, top, sn);
+        limb_t* z1 = take(scratch, top, 2 * sn);
+        std::copy(a, a + m, sa);
+        add_limbs(sa, sn, a + m, an - m);
+        std::copy(b, b + m, sb);
+        add_limbs(sb, sn, b + m, bn - m);
+        mul(sa, sn, sb, sn, z1, scratch, top);
+
+        // z1 = (a0 + a1)(b0 + b1) - z0 - z2
+        sub_limbs(z1, 2 * sn, r, 2 * m);
+        sub_limbs(z1, 2 * sn, r + 2 * m, an + bn - 2 * m);
+        size_t zn = 2 * sn;
+        while (zn > 0 && z1[zn - 1] == 0)
+            --zn;
+        add_limbs(r + m, an + bn - m, z1, zn);
+        top = mark;
+    }
+
+    std::vector<limb_t> m_limbs;
+    bool m_negative;
+};
+
+template<> struct integral_trait<big_integer>
+    { enum { is_integral = true, }; };
+
+namespace std {
+template<> struct hash<big_integer> {
+    size_t operator()(const big_integer& b) const { return hash_value(b); }
+};
+}
+
+#endif
@@ -7,6 +7,12 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <vector>
+#include "conststr.h"
+#include "static_vector.h"
+#ifdef BENCH
+#include "bench.h"
+#endif
 
 // C++11 constexpr functions use recursion rather than iteration
 // (C++14 constexpr functions may use local variables and loops)
@@ -15,23 +21,6 @@ constexpr int factorial(int n)
     return n <= 1? 1 : (n * factorial(n - 1));
 }
 
-// literal class
-class conststr {
-    const char* p;
-    std::size_t sz;
-public:
-    template<std::size_t N>
-    constexpr conststr(const char(&a)[N]): p(a), sz(N - 1) {}
- 
-    // constexpr functions signal errors by throwing exceptions
-    // in C++11, they must do so from the conditional operator ?:
-    constexpr char operator[](std::size_t n) const
-    {
-        return n < sz? p[n] : throw std::out_of_range("");
-    }
-    constexpr std::size_t size() const { return sz; }
-};
-
 // C++11 constexpr functions had to put everything in a single return statement
 // (C++14 doesn't have that requirement)
 constexpr std::size_t countlower(conststr s, std::size_t n = 0,
@@ -56,6 +45,7 @@ constexpr int length(const T(&ary)[N])
     return N; 
 } 
 
+#ifndef BENCH
 int main ()
 {
   std::cout << "4! = " ;
@@ -76,5 +66,65 @@ int main ()
   }
   std::cout << std::endl;
 
+  // a container with the same compile-time capacity, stored inline
+  static_vector<int, length(nums) * 2> list(nums);
+  list.push_back(5);
+  list.insert(list.begin(), 0);
+  list.erase(list.begin() + 2);
+  for(auto x : list) {
+    std:: cout << x << " ";
+  }
+  std::cout << std::endl; // 0 1 3 4 5
+
+  constexpr static_vector<int, length(nums)> clist(nums);
+  std::cout << "clist[3] = ";
+  constN<clist[3]> out3; // built and indexed at compile time
+
   return 0;
 }
+#else
+int main (int argc, char* argv[])
+{
+  bench::suite suite("constexpr", argc, argv);
+
+  int k = 12;
+  suite.run("factorial", [&] {
+    bench::do_not_optimize(k);
+    bench::do_not_optimize(factorial(k));
+  });
+
+  char hello[] = "Hello, world!";
+  suite.run("countlower", [&] {
+    bench::do_not_optimize(hello);
+    bench::do_not_optimize(countlower(hello));
+  });
+
+  // short lists with a known bound: heap vs inline storage
+  const int nums2[8] { 1, 2, 3, 4, 5, 6, 7, 8 };
+  int n = length(nums2);
+  suite.run("build_vector", [&] {
+    bench::do_not_optimize(n);
+    std::vector<int> v;
+    for (int i = 0; i < n; ++i)
+      v.push_back(i);
+    bench::do_not_optimize(v.data());
+  });
+  suite.run("build_vector_reserved", [&] {
+    bench::do_not_optimize(n);
+    std::vector<int> v;
+    v.reserve(n);
+    for (int i = 0; i < n; ++i)
+      v.push_back(i);
+    bench::do_not_optimize(v.data());
+  });
+  suite.run("build_static_vector", [&] {
+    bench::do_not_optimize(n);
+    static_vector<int, length(nums2)> v;
+    for (int i = 0; i < n; ++i)
+      v.push_back(i);
+    bench::do_not_optimize(v.data());
+  });
+
+  return suite.finish();
+}
+#endif
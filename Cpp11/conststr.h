@@ -0,0 +1,34 @@
+//
+//  conststr.h
+//
+//  Modified by 罗铮 on 04/18/21.
+//  http://en.cppreference.com/w/cpp/language/constexpr
+//
+//  A string literal usable in constant expressions, shared by
+//  constexpr.cpp and format.h.
+
+#ifndef CONSTSTR_H
+#define CONSTSTR_H
+
+#include <cstddef>
+#include <stdexcept>
+
+// literal class
+class conststr {
+    const char* p;
+    std::size_t sz;
+public:
+    template<std::size_t N>
+    constexpr conststr(const char(&a)[N]): p(a), sz(N - 1) {}
+ 
+    // constexpr functions signal errors by throwing exceptions
+    // in C++11, they must do so from the conditional operator ?:
+    constexpr char operator[](std::size_t n) const
+    {
+        return n < sz? p[n] : throw std::out_of_range("");
+    }
+    constexpr std::size_t size() const { return sz; }
+    constexpr const char* data() const { return p; }
+};
+
+#endif
@@ -5,6 +5,11 @@
 //  https://segmentfault.com/a/1190000003901666
 
 #include <iostream>
+#include <string>
+#include "tagged_value.h"
+#ifdef BENCH
+#include "bench.h"
+#endif
 
 using namespace std;
 
@@ -26,9 +31,51 @@ void what_am_i(T) {
     cout << "Pointer." << endl;
 }
 
+void what_am_i(string_ref) {
+    cout << "String." << endl;
+}
+
+void what_am_i(null_value) {
+    cout << "Nothing." << endl;
+}
+
+// the overloads above, chosen at run time for what a tagged_value holds
+struct what_am_i_visitor {
+    template<typename T>
+    void operator()(T x) const { what_am_i(x); }
+};
+
+#ifndef BENCH
 int main()
 {
     what_am_i(123);
     what_am_i(123.0);
     what_am_i("123");
+
+    tagged_value values[] = { 123, 123.0, "123", string("123"), tagged_value() };
+    for (const tagged_value& v : values)
+        visit(what_am_i_visitor(), v);
+}
+#else
+int main(int argc, char* argv[])
+{
+    bench::suite suite("enable_if", argc, argv);
+
+    bench::null_buf null;
+    streambuf* old = cout.rdbuf(&null);
+    int i = 123;
+    double d = 123.0;
+    const char* p = "123";
+    suite.run("what_am_i_integral", [&] { what_am_i(i); });
+    suite.run("what_am_i_floating_point", [&] { what_am_i(d); });
+    suite.run("what_am_i_pointer", [&] { what_am_i(p); });
+    tagged_value values[] = { i, d, p, string("123") };
+    suite.run("what_am_i_tagged_value", [&] {
+        for (const tagged_value& v : values)
+            visit(what_am_i_visitor(), v);
+    });
+    cout.rdbuf(old);
+
+    return suite.finish();
 }
+#endif
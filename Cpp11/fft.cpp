@@ -0,0 +1,122 @@
+//
+//  fft.cpp
+//
+//  Created on 10/19/26.
+//
+//  fft.h in use: complex arithmetic on cmplx, fixed-size transforms of
+//  vec<cmplx<double>, N>, and GFLOP/s of the element-wise kernels and of
+//  the FFT across power-of-two and mixed-radix sizes, on one thread and
+//  on a thread_pool.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include "fft.h"
+
+using namespace std;
+
+typedef cmplx<double> c;
+
+template<typename F>
+double time_ns(F f, int reps) {
+    f(); // warm up
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < reps; ++i)
+        f();
+    chrono::duration<double, nano> ns = chrono::steady_clock::now() - start;
+    return ns.count() / reps;
+}
+
+string radices_of(const fft_plan& p) {
+    string s;
+    for (size_t r : p.radices())
+        s += (s.empty() ? "" : "x") + to_string(r);
+    return s;
+}
+
+vector<c> signal(size_t n) {
+    vector<c> x(n);
+    for (size_t i = 0; i < n; ++i)
+        x[i] = c{ cos(0.1 * double(i)), sin(0.37 * double(i)) };
+    return x;
+}
+
+int main()
+{
+    c a{1, 2}, b{3, -1};
+    cout << a * b << " " << conj(a) << " " << norm(a) << endl; // 5+5i 1+-2i 5
+
+    vec<c, 8> v{c{1, 0}, c{1, 0}, c{1, 0}, c{1, 0},
+                c{0, 0}, c{0, 0}, c{0, 0}, c{0, 0}};
+    fft(v);
+    cout << v << endl; // 4+0i 1+-2.41421i 0+0i 1+-0.414214i 0+0i ...
+    ifft(v);
+    cout << "ifft(fft(v)) == v: " << (abs(v[0] + c{-1, 0}) < 1e-15 &&
+                                      abs(v[7]) < 1e-15) << endl; // 1
+
+    vector<c> x = signal(360), y = x;
+    fft_plan p360(360);
+    p360.forward(y);
+    p360.inverse(y);
+    double err = 0;
+    for (size_t i = 0; i < x.size(); ++i)
+        err = max(err, abs(y[i] + c{ -x[i][0], -x[i][1] }));
+    cout << "radices of 360: " << radices_of(p360)
+         << ", round trip error " << (err < 1e-12 ? "< 1e-12" : to_string(err)) << endl;
+
+    /////////////////////////////////////////////////////////
+    const size_t n = 1 << 12;
+    vector<c> ka = signal(n), kb = signal(n), kout(n);
+    vector<double> are(n), aim(n), bre(n), bim(n), ore(n), oim(n);
+    cx::deinterleave(are.data(), aim.data(), ka.data(), n);
+    cx::deinterleave(bre.data(), bim.data(), kb.data(), n);
+    const int reps = 2000;
+    double t_ops = time_ns([&] {
+        for (size_t i = 0; i < n; ++i)
+            kout[i] = ka[i] * kb[i];
+    }, reps);
+    double t_inter = time_ns([&] {
+        cx::interleaved::mul(kout.data(), ka.data(), kb.data(), n); }, reps);
+    double t_split = time_ns([&] {
+        cx::split::mul(ore.data(), oim.data(), are.data(), aim.data(),
+                       bre.data(), bim.data(), n); }, reps);
+    cout << "complex multiply, " << n << " elements, GFLOP/s: " << fixed
+         << setprecision(2) << "cmplx operator* " << 6.0 * n / t_ops
+         << ", interleaved " << 6.0 * n / t_inter
+         << ", split " << 6.0 * n / t_split << endl;
+
+    /////////////////////////////////////////////////////////
+    thread_pool pool;
+    const size_t sizes[] = {
+        1 << 4, 1 << 6, 1 << 8, 1 << 10, 1 << 12, 1 << 14, 1 << 16, 1 << 18,
+        1 << 20, 1000, 3 * 3 * 3 * 3 * 3 * 3 * 3 * 3 * 3, 5 * 5 * 5 * 5 * 5 * 5,
+        7 * 11 * 13 * 17, 1 << 17 | 1 << 16, 1000000,
+    };
+    cout << "FFT GFLOP/s (5 n log2 n), " << pool.size() << " threads in the pool"
+         << endl;
+    cout << setw(9) << "size" << setw(16) << "radices" << setw(10) << "1 thread"
+         << setw(10) << "pool" << endl;
+    for (size_t size : sizes) {
+        fft_plan serial(size), threaded(size, &pool);
+        vector<c> data = signal(size);
+        int r = int(max<size_t>(1, (size_t(1) << 21) / size));
+        // forward and back keeps the values bounded across repetitions
+        double t1 = time_ns([&] {
+            serial.forward(data.data());
+            serial.inverse(data.data());
+        }, r) / 2;
+        double tn = time_ns([&] {
+            threaded.forward(data.data());
+            threaded.inverse(data.data());
+        }, r) / 2;
+        string rad = radices_of(serial);
+        if (rad.size() > 15)
+            rad = rad.substr(0, 12) + "...";
+        cout << setw(9) << size << setw(16) << rad
+             << setw(10) << fft_plan::flops(size) / t1
+             << setw(10) << fft_plan::flops(size) / tn << endl;
+    }
+}
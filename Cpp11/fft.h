@@ -0,0 +1,582 @@
+//
+//  fft.h
+//
+//  Created on 10/19/26.
+//  http://www.fftw.org/fftw-paper-ieee.pdf
+//  https://en.wikipedia.org/wiki/Cooley%E2%80%93Tukey_FFT_algorithm
+//
+//  Complex kernels over interleaved (cmplx<double>[n]) and split (re[n],
+//  im[n]) layouts, and an in-place mixed-radix FFT. A plan factors n into
+//  radices 4, 2, 3, 5 and whatever primes remain, precomputes the twiddles
+//  of every stage and the digit-reversal permutation, then runs the
+//  decimation-in-time stages: the leading ones cache block by cache block,
+//  the rest over the whole buffer, split across a thread_pool for large n.
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "CRTP.h"
+#include "thread_pool.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static_assert(sizeof(cmplx<double>) == 2 * sizeof(double),
+              "cmplx<double> must be laid out like double[2]");
+
+////////////////////////////////////////////////////////////
+// One complex double per register, { re, im }
+struct cx_ops {
+#if defined(__SSE2__)
+    typedef __m128d reg;
+    static reg load(const cmplx<double>& c) { return _mm_loadu_pd(c.data()); }
+    static void store(cmplx<double>& c, reg r) { _mm_storeu_pd(c.data(), r); }
+    static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+    static reg scale(reg a, double s) { return _mm_mul_pd(a, _mm_set1_pd(s)); }
+    static reg swap(reg a) { return _mm_shuffle_pd(a, a, 1); }
+    static reg conj(reg a) { return _mm_xor_pd(a, _mm_set_pd(-0.0, 0.0)); }
+    static reg mul(reg a, reg b) {
+        reg t1 = _mm_mul_pd(a, _mm_unpacklo_pd(b, b));       // ar*br, ai*br
+        reg t2 = _mm_mul_pd(swap(a), _mm_unpackhi_pd(b, b)); // ai*bi, ar*bi
+        return _mm_add_pd(t1, _mm_xor_pd(t2, _mm_set_pd(0.0, -0.0)));
+    }
+    // a * conj(b)
+    static reg mul_conj(reg a, reg b) {
+        reg t1 = _mm_mul_pd(a, _mm_unpacklo_pd(b, b));
+        reg t2 = _mm_mul_pd(swap(a), _mm_unpackhi_pd(b, b));
+        return _mm_add_pd(t1, _mm_xor_pd(t2, _mm_set_pd(-0.0, 0.0)));
+    }
+    static reg mul_i(reg a) { return _mm_xor_pd(swap(a), _mm_set_pd(0.0, -0.0)); }
+    static reg mul_neg_i(reg a) { return _mm_xor_pd(swap(a), _mm_set_pd(-0.0, 0.0)); }
+#else
+    struct reg { double re, im; };
+    static reg load(const cmplx<double>& c) { return reg{ c[0], c[1] }; }
+    static void store(cmplx<double>& c, reg r) { c[0] = r.re; c[1] = r.im; }
+    static reg add(reg a, reg b) { return reg{ a.re + b.re, a.im + b.im }; }
+    static reg sub(reg a, reg b) { return reg{ a.re - b.re, a.im - b.im }; }
+    static reg scale(reg a, double s) { return reg{ a.re * s, a.im * s }; }
+    static reg conj(reg a) { return reg{ a.re, -a.im }; }
+    static reg mul(reg a, reg b)
+        { return reg{ a.re * b.re - a.im * b.im, a.im * b.re + a.re * b.im }; }
+    static reg mul_conj(reg a, reg b)
+        { return reg{ a.re * b.re + a.im * b.im, a.im * b.re - a.re * b.im }; }
+    static reg mul_i(reg a) { return reg{ -a.im, a.re }; }
+    static reg mul_neg_i(reg a) { return reg{ a.im, -a.re }; }
+#endif
+};
+
+////////////////////////////////////////////////////////////
+// Element-wise kernels. Outputs may alias inputs.
+namespace cx {
+
+namespace interleaved {
+
+inline void mul(cmplx<double>* out, const cmplx<double>* a,
+                const cmplx<double>* b, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        cx_ops::store(out[i], cx_ops::mul(cx_ops::load(a[i]), cx_ops::load(b[i])));
+}
+
+// a * conj(b), the product behind correlation
+inline void mul_conj(cmplx<double>* out, const cmplx<double>* a,
+                     const cmplx<double>* b, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        cx_ops::store(out[i],
+                      cx_ops::mul_conj(cx_ops::load(a[i]), cx_ops::load(b[i])));
+}
+
+inline void conj(cmplx<double>* out, const cmplx<double>* a, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        cx_ops::store(out[i], cx_ops::conj(cx_ops::load(a[i])));
+}
+
+// squared magnitude
+inline void norm(double* out, const cmplx<double>* a, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(a[i].data()), y = _mm_loadu_pd(a[i + 1].data());
+        x = _mm_mul_pd(x, x);
+        y = _mm_mul_pd(y, y);
+        _mm_storeu_pd(out + i, _mm_add_pd(_mm_unpacklo_pd(x, y),
+                                          _mm_unpackhi_pd(x, y)));
+    }
+#endif
+    for (; i < n; ++i)
+        out[i] = ::norm(a[i]);
+}
+
+inline void abs(double* out, const cmplx<double>* a, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        __m128d x = _mm_loadu_pd(a[i].data()), y = _mm_loadu_pd(a[i + 1].data());
+        x = _mm_mul_pd(x, x);
+        y = _mm_mul_pd(y, y);
+        _mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_add_pd(_mm_unpacklo_pd(x, y),
+                                                      _mm_unpackhi_pd(x, y))));
+    }
+#endif
+    for (; i < n; ++i)
+        out[i] = ::abs(a[i]);
+}
+
+} // namespace interleaved
+
+namespace split {
+
+inline void mul(double* out_re, double* out_im,
+                const double* a_re, const double* a_im,
+                const double* b_re, const double* b_im, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        __m128d ar = _mm_loadu_pd(a_re + i), ai = _mm_loadu_pd(a_im + i);
+        __m128d br = _mm_loadu_pd(b_re + i), bi = _mm_loadu_pd(b_im + i);
+        _mm_storeu_pd(out_re + i, _mm_sub_pd(_mm_mul_pd(ar, br), _mm_mul_pd(ai, bi)));
+        _mm_storeu_pd(out_im + i, _mm_add_pd(_mm_mul_pd(ar, bi), _mm_mul_pd(ai, br)));
+    }
+#endif
+    for (; i < n; ++i) {
+        double re = a_re[i] * b_re[i] - a_im[i] * b_im[i];
+        double im = a_re[i] * b_im[i] + a_im[i] * b_re[i];
+        out_re[i] = re;
+        out_im[i] = im;
+    }
+}
+
+inline void mul_conj(double* out_re, double* out_im,
+                     const double* a_re, const double* a_im,
+                     const double* b_re, const double* b_im, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        __m128d ar = _mm_loadu_pd(a_re + i), ai = _mm_loadu_pd(a_im + i);
+        __m128d br = _mm_loadu_pd(b_re + i), bi = _mm_loadu_pd(b_im + i);
+        _mm_storeu_pd(out_re + i, _mm_add_pd(_mm_mul_pd(ar, br), _mm_mul_pd(ai, bi)));
+        _mm_storeu_pd(out_im + i, _mm_sub_pd(_mm_mul_pd(ai, br), _mm_mul_pd(ar, bi)));
+    }
+#endif
+    for (; i < n; ++i) {
+        double re = a_re[i] * b_re[i] + a_im[i] * b_im[i];
+        double im = a_im[i] * b_re[i] - a_re[i] * b_im[i];
+        out_re[i] = re;
+        out_im[i] = im;
+    }
+}
+
+inline void conj(double* out_re, double* out_im,
+                 const double* a_re, const double* a_im, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out_re[i] = a_re[i];
+        out_im[i] = -a_im[i];
+    }
+}
+
+inline void norm(double* out, const double* a_re, const double* a_im, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        __m128d re = _mm_loadu_pd(a_re + i), im = _mm_loadu_pd(a_im + i);
+        _mm_storeu_pd(out + i, _mm_add_pd(_mm_mul_pd(re, re), _mm_mul_pd(im, im)));
+    }
+#endif
+    for (; i < n; ++i)
+        out[i] = a_re[i] * a_re[i] + a_im[i] * a_im[i];
+}
+
+inline void abs(double* out, const double* a_re, const double* a_im, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        __m128d re = _mm_loadu_pd(a_re + i), im = _mm_loadu_pd(a_im + i);
+        _mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(re, re),
+                                                      _mm_mul_pd(im, im))));
+    }
+#endif
+    for (; i < n; ++i)
+        out[i] = std::sqrt(a_re[i] * a_re[i] + a_im[i] * a_im[i]);
+}
+
+} // namespace split
+
+inline void deinterleave(double* re, double* im, const cmplx<double>* a, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        re[i] = a[i][0];
+        im[i] = a[i][1];
+    }
+}
+
+inline void interleave(cmplx<double>* out, const double* re, const double* im,
+                       size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        out[i] = cmplx<double>{ re[i], im[i] };
+}
+
+} // namespace cx
+
+////////////////////////////////////////////////////////////
+// Butterflies. Each combines radix transforms of length m, x[q * m] for
+// q < radix, after multiplying x[q * m] by the twiddle w[q - 1]. The
+// forward transform uses e^(-2 pi i k / n); the inverse conjugates.
+template<bool Inverse> struct fft_dir {
+    static cx_ops::reg twiddle(cx_ops::reg a, cx_ops::reg w)
+        { return cx_ops::mul(a, w); }
+    static cx_ops::reg rot(cx_ops::reg a) { return cx_ops::mul_neg_i(a); }
+};
+
+template<> struct fft_dir<true> {
+    static cx_ops::reg twiddle(cx_ops::reg a, cx_ops::reg w)
+        { return cx_ops::mul_conj(a, w); }
+    static cx_ops::reg rot(cx_ops::reg a) { return cx_ops::mul_i(a); }
+};
+
+template<bool Inverse> struct radix2 {
+    enum { radix = 2, };
+    static void run(cmplx<double>* x, size_t m, const cmplx<double>* w) {
+        typedef cx_ops o;
+        o::reg x0 = o::load(x[0]);
+        o::reg x1 = fft_dir<Inverse>::twiddle(o::load(x[m]), o::load(w[0]));
+        o::store(x[0], o::add(x0, x1));
+        o::store(x[m], o::sub(x0, x1));
+    }
+};
+
+template<bool Inverse> struct radix3 {
+    enum { radix = 3, };
+    static void run(cmplx<double>* x, size_t m, const cmplx<double>* w) {
+        typedef cx_ops o;
+        typedef fft_dir<Inverse> d;
+        const double half_sqrt3 = 0.86602540378443864676;
+        o::reg x0 = o::load(x[0]);
+        o::reg x1 = d::twiddle(o::load(x[m]), o::load(w[0]));
+        o::reg x2 = d::twiddle(o::load(x[2 * m]), o::load(w[1]));
+        o::reg s = o::add(x1, x2);
+        o::reg t = o::sub(x0, o::scale(s, 0.5));
+        o::reg u = d::rot(o::scale(o::sub(x1, x2), half_sqrt3));
+        o::store(x[0], o::add(x0, s));
+        o::store(x[m], o::add(t, u));
+        o::store(x[2 * m], o::sub(t, u));
+    }
+};
+
+template<bool Inverse> struct radix4 {
+    enum { radix = 4, };
+    static void run(cmplx<double>* x, size_t m, const cmplx<double>* w) {
+        typedef cx_ops o;
+        typedef fft_dir<Inverse> d;
+        o::reg x0 = o::load(x[0]);
+        o::reg x1 = d::twiddle(o::load(x[m]), o::load(w[0]));
+        o::reg x2 = d::twiddle(o::load(x[2 * m]), o::load(w[1]));
+        o::reg x3 = d::twiddle(o::load(x[3 * m]), o::load(w[2]));
+        o::reg a = o::add(x0, x2), b = o::sub(x0, x2);
+        o::reg c = o::add(x1, x3), e = d::rot(o::sub(x1, x3));
+        o::store(x[0], o::add(a, c));
+        o::store(x[m], o::add(b, e));
+        o::store(x[2 * m], o::sub(a, c));
+        o::store(x[3 * m], o::sub(b, e));
+    }
+};
+
+template<bool Inverse> struct radix5 {
+    enum { radix = 5, };
+    static void run(cmplx<double>* x, size_t m, const cmplx<double>* w) {
+        typedef cx_ops o;
+        typedef fft_dir<Inverse> d;
+        const double c1 = 0.30901699437494742410;   // cos(2 pi / 5)
+        const double c2 = -0.80901699437494742410;  // cos(4 pi / 5)
+        const double s1 = 0.95105651629515357212;   // sin(2 pi / 5)
+        const double s2 = 0.58778525229247312917;   // sin(4 pi / 5)
+        o::reg x0 = o::load(x[0]);
+        o::reg x1 = d::twiddle(o::load(x[m]), o::load(w[0]));
+        o::reg x2 = d::twiddle(o::load(x[2 * m]), o::load(w[1]));
+        o::reg x3 = d::twiddle(o::load(x[3 * m]), o::load(w[2]));
+        o::reg x4 = d::twiddle(o::load(x[4 * m]), o::load(w[3]));
+        o::reg t1 = o::add(x1, x4), t2 = o::add(x2, x3);
+        o::reg t3 = o::sub(x1, x4), t4 = o::sub(x2, x3);
+        o::reg a1 = o::add(x0, o::add(o::scale(t1, c1), o::scale(t2, c2)));
+        o::reg a2 = o::add(x0, o::add(o::scale(t1, c2), o::scale(t2, c1)));
+        o::reg b1 = d::rot(o::add(o::scale(t3, s1), o::scale(t4, s2)));
+        o::reg b2 = d::rot(o::sub(o::scale(t3, s2), o::scale(t4, s1)));
+        o::store(x[0], o::add(x0, o::add(t1, t2)));
+        o::store(x[m], o::add(a1, b1));
+        o::store(x[2 * m], o::add(a2, b2));
+        o::store(x[3 * m], o::sub(a2, b2));
+        o::store(x[4 * m], o::sub(a1, b1));
+    }
+};
+
+////////////////////////////////////////////////////////////
+class fft_plan {
+public:
+    // leading stages whose transforms fit in this many elements run block
+    // by block; transforms of at least parallel_size use the pool
+    enum { cache_block = 1 << 13, parallel_size = 1 << 15, chunks = 64, };
+
+    explicit fft_plan(size_t n, thread_pool* pool = nullptr)
+        : m_n(n), m_pool(pool), m_blocked(0), m_block(1) {
+        if (n > UINT32_MAX)
+            throw std::invalid_argument("fft_plan: size too large");
+        make_stages();
+        make_permutation();
+    }
+
+    size_t size() const { return m_n; }
+
+    std::vector<size_t> radices() const {
+        std::vector<size_t> r;
+        for (const stage& s : m_stages)
+            r.push_back(s.radix);
+        return r;
+    }
+
+    void forward(cmplx<double>* data) const { transform<false>(data); }
+
+    // scaled by 1/n, so that inverse undoes forward
+    void inverse(cmplx<double>* data) const {
+        transform<true>(data);
+        const double s = 1.0 / double(m_n);
+        for_range(m_n, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i)
+                cx_ops::store(data[i], cx_ops::scale(cx_ops::load(data[i]), s));
+        });
+    }
+
+    void forward(std::vector<cmplx<double>>& v) const {
+        check_size(v.size());
+        forward(v.data());
+    }
+
+    void inverse(std::vector<cmplx<double>>& v) const {
+        check_size(v.size());
+        inverse(v.data());
+    }
+
+    // the customary 5 n log2(n) operation count used to quote FFT speed
+    static double flops(size_t n) { return 5.0 * double(n) * std::log2(double(n)); }
+
+private:
+    struct stage {
+        size_t radix;
+        size_t m;         // length of the transforms being combined
+        size_t twiddles;  // offset of (radix - 1) * m twiddles in m_twiddles
+        size_t roots;     // offset of radix roots in m_roots, generic only
+    };
+
+    void check_size(size_t n) const {
+        if (n != m_n)
+            throw std::invalid_argument("fft_plan: buffer size differs from plan");
+    }
+
+    static cmplx<double> root(size_t k, size_t n) {
+        const double pi = 3.14159265358979323846;
+        const double angle = -2 * pi * double(k % n) / double(n);
+        return cmplx<double>{ std::cos(angle), std::sin(angle) };
+    }
+
+    void make_stages() {
+        size_t rest = m_n, m = 1;
+        auto add_stage = [&](size_t r) {
+            stage s = { r, m, m_twiddles.size(), m_roots.size() };
+            for (size_t j = 0; j < m; ++j)
+                for (size_t q = 1; q < r; ++q)
+                    m_twiddles.push_back(root(j * q, r * m));
+            if (r > 5)
+                for (size_t k = 0; k < r; ++k)
+                    m_roots.push_back(root(k, r));
+            m_stages.push_back(s);
+            m *= r;
+            rest /= r;
+            if (m <= cache_block) {
+                m_blocked = m_stages.size();
+                m_block = m;
+            }
+        };
+        while (rest > 1 && rest % 4 == 0)
+            add_stage(4);
+        if (rest > 1 && rest % 2 == 0)
+            add_stage(2);
+        for (size_t p = 3; rest > 1; p += 2) {
+            if (p * p > rest)
+                p = rest;
+            while (rest % p == 0)
+                add_stage(p);
+        }
+    }
+
+    // Stage s reads the digits of an index from the least significant up,
+    // so the input goes in digit-reversed order: element i moves to the
+    // position whose digits, most significant first, are those of i read
+    // from the least significant. Kept as cycles for an in-place shuffle.
+    void make_permutation() {
+        if (m_n < 2)
+            return;
+        std::vector<uint32_t> rev(m_n);
+        for (size_t p = 0; p < m_n; ++p) {
+            size_t q = p, r = 0, weight = m_n;
+            for (const stage& s : m_stages) {
+                weight /= s.radix;
+                r += q % s.radix * weight;
+                q /= s.radix;
+            }
+            rev[p] = uint32_t(r);
+        }
+        std::vector<bool> done(m_n);
+        m_cycle_begin.push_back(0);
+        for (size_t p = 0; p < m_n; ++p) {
+            if (done[p] || rev[p] == p)
+                continue;
+            size_t cur = p;
+            do {
+                m_cycles.push_back(uint32_t(cur));
+                done[cur] = true;
+                cur = rev[cur];
+            } while (cur != p);
+            m_cycle_begin.push_back(m_cycles.size());
+        }
+    }
+
+    bool parallel() const {
+        return m_pool && m_pool->size() > 1 && m_n >= size_t(parallel_size);
+    }
+
+    // f(lo, hi) over [0, n), in chunks on the pool for large transforms
+    template<typename F>
+    void for_range(size_t n, const F& f) const {
+        if (!parallel() || n < size_t(chunks)) {
+            f(0, n);
+            return;
+        }
+        parallel_for(*m_pool, 0, chunks, 1, [&](size_t c) {
+            f(n * c / chunks, n * (c + 1) / chunks);
+        });
+    }
+
+    void permute(cmplx<double>* a) const {
+        for_range(m_cycle_begin.size() - 1, [&](size_t lo, size_t hi) {
+            for (size_t c = lo; c < hi; ++c) {
+                const uint32_t* p = &m_cycles[m_cycle_begin[c]];
+                const uint32_t* last = &m_cycles[m_cycle_begin[c + 1] - 1];
+                cx_ops::reg first = cx_ops::load(a[*p]);
+                for (; p != last; ++p)
+                    a[p[0]] = a[p[1]];
+                cx_ops::store(a[*last], first);
+            }
+        });
+    }
+
+    template<typename Butterfly>
+    static void butterflies(cmplx<double>* a, size_t m, const cmplx<double>* tw,
+                            size_t g_lo, size_t g_hi, size_t j_lo, size_t j_hi) {
+        const size_t r = Butterfly::radix, len = r * m;
+        for (size_t g = g_lo; g < g_hi; ++g)
+            for (size_t j = j_lo; j < j_hi; ++j)
+                Butterfly::run(a + g * len + j, m, tw + j * (r - 1));
+    }
+
+    template<bool Inverse>
+    void butterflies_generic(cmplx<double>* a, const stage& s,
+                             size_t g_lo, size_t g_hi,
+                             size_t j_lo, size_t j_hi) const {
+        typedef cx_ops o;
+        typedef fft_dir<Inverse> d;
+        const size_t r = s.radix, m = s.m, len = r * m;
+        const cmplx<double>* tw = &m_twiddles[s.twiddles];
+        const cmplx<double>* roots = &m_roots[s.roots];
+        std::vector<cmplx<double>> x(r);
+        for (size_t g = g_lo; g < g_hi; ++g)
+            for (size_t j = j_lo; j < j_hi; ++j) {
+                cmplx<double>* base = a + g * len + j;
+                const cmplx<double>* w = tw + j * (r - 1);
+                x[0] = base[0];
+                for (size_t q = 1; q < r; ++q)
+                    o::store(x[q], d::twiddle(o::load(base[q * m]), o::load(w[q - 1])));
+                for (size_t p = 0; p < r; ++p) {
+                    o::reg acc = o::load(x[0]);
+                    for (size_t q = 1, k = p; q < r; ++q, k = (k + p) % r)
+                        acc = o::add(acc, d::twiddle(o::load(x[q]), o::load(roots[k])));
+                    o::store(base[p * m], acc);
+                }
+            }
+    }
+
+    template<bool Inverse>
+    void run_stage(cmplx<double>* a, const stage& s, size_t g_lo, size_t g_hi,
+                   size_t j_lo, size_t j_hi) const {
+        const cmplx<double>* tw = &m_twiddles[s.twiddles];
+        switch (s.radix) {
+        case 2: butterflies<radix2<Inverse>>(a, s.m, tw, g_lo, g_hi, j_lo, j_hi); break;
+        case 3: butterflies<radix3<Inverse>>(a, s.m, tw, g_lo, g_hi, j_lo, j_hi); break;
+        case 4: butterflies<radix4<Inverse>>(a, s.m, tw, g_lo, g_hi, j_lo, j_hi); break;
+        case 5: butterflies<radix5<Inverse>>(a, s.m, tw, g_lo, g_hi, j_lo, j_hi); break;
+        default: butterflies_generic<Inverse>(a, s, g_lo, g_hi, j_lo, j_hi); break;
+        }
+    }
+
+    template<bool Inverse>
+    void transform(cmplx<double>* a) const {
+        if (m_n < 2)
+            return;
+        permute(a);
+        // the leading stages, one cache-sized block at a time
+        if (m_blocked)
+            for_range(m_n / m_block, [&](size_t lo, size_t hi) {
+                for (size_t b = lo; b < hi; ++b)
+                    for (size_t i = 0; i < m_blocked; ++i) {
+                        const stage& s = m_stages[i];
+                        run_stage<Inverse>(a + b * m_block, s,
+                                           0, m_block / (s.radix * s.m), 0, s.m);
+                    }
+            });
+        // the rest over the whole buffer, split by group while there are
+        // enough groups and by position within the group after that
+        for (size_t i = m_blocked; i < m_stages.size(); ++i) {
+            const stage& s = m_stages[i];
+            const size_t groups = m_n / (s.radix * s.m);
+            if (groups >= size_t(chunks))
+                for_range(groups, [&](size_t lo, size_t hi) {
+                    run_stage<Inverse>(a, s, lo, hi, 0, s.m);
+                });
+            else
+                for_range(s.m, [&](size_t lo, size_t hi) {
+                    run_stage<Inverse>(a, s, 0, groups, lo, hi);
+                });
+        }
+    }
+
+    size_t m_n;
+    thread_pool* m_pool;
+    std::vector<stage> m_stages;
+    size_t m_blocked;  // number of leading stages run block by block
+    size_t m_block;    // their combined length
+    std::vector<cmplx<double>> m_twiddles;
+    std::vector<cmplx<double>> m_roots;
+    std::vector<uint32_t> m_cycles;
+    std::vector<size_t> m_cycle_begin;
+};
+
+////////////////////////////////////////////////////////////
+// Fixed-size transforms share one plan per size
+template<size_t N>
+const fft_plan& fft_plan_for() {
+    static const fft_plan plan(N);
+    return plan;
+}
+
+template<size_t N>
+void fft(vec<cmplx<double>, N>& v) {
+    fft_plan_for<N>().forward(v.data());
+}
+
+template<size_t N>
+void ifft(vec<cmplx<double>, N>& v) {
+    fft_plan_for<N>().inverse(v.data());
+}
+
+#endif
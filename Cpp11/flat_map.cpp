@@ -0,0 +1,156 @@
+//
+//  flat_map.cpp
+//
+//  Created on 10/19/26.
+//
+//  flat_map.h in use, and how it compares with std::map: building from
+//  unsorted keys, successful and failed lookups in random order, and a
+//  full iteration, for int and std::string keys from a hundred to a
+//  million entries. Batched insertion is timed against inserting the
+//  same keys one at a time.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "flat_map.h"
+
+using namespace std;
+
+template <typename T, typename U>
+ostream& operator<<(ostream& out, const pair<T, U>& p) {
+    out << "[" << p.first << ", " << p.second << "]";
+    return out;
+}
+
+template<typename F>
+double time_ns(F f, size_t ops) {
+    auto start = chrono::steady_clock::now();
+    f();
+    chrono::duration<double, nano> ns = chrono::steady_clock::now() - start;
+    return ns.count() / double(ops);
+}
+
+template<typename K> K make_key(size_t i);
+template<> int make_key<int>(size_t i) { return int(i * 2654435761u >> 1); }
+template<> string make_key<string>(size_t i) { return "key:" + to_string(i * 2654435761u); }
+
+template<typename K>
+void compare(const char* name, size_t n) {
+    mt19937 rng(7);
+    vector<pair<K, int>> input;
+    for (size_t i = 0; i < n; ++i)
+        input.emplace_back(make_key<K>(i), int(i));
+    shuffle(input.begin(), input.end(), rng);
+    // every key once, then as many keys that are not there
+    vector<K> hits, misses;
+    for (size_t i = 0; i < n; ++i) {
+        hits.push_back(input[i].first);
+        misses.push_back(make_key<K>(n + i));
+    }
+    shuffle(hits.begin(), hits.end(), rng);
+    const size_t rounds = max<size_t>(1, 2000000 / n);
+
+    map<K, int> m;
+    flat_map<K, int> f;
+    double build_m = time_ns([&] { m = map<K, int>(input.begin(), input.end()); }, n);
+    double build_f = time_ns([&] { f = flat_map<K, int>(input.begin(), input.end()); }, n);
+
+    long sum_m = 0, sum_f = 0;
+    double find_m = time_ns([&] {
+        for (size_t r = 0; r < rounds; ++r) {
+            for (const K& k : hits)
+                sum_m += m.find(k)->second;
+            for (const K& k : misses)
+                sum_m += m.count(k);
+        }
+    }, 2 * n * rounds);
+    double find_f = time_ns([&] {
+        for (size_t r = 0; r < rounds; ++r) {
+            for (const K& k : hits)
+                sum_f += f.find(k)->second;
+            for (const K& k : misses)
+                sum_f += f.count(k);
+        }
+    }, 2 * n * rounds);
+
+    double iter_m = time_ns([&] {
+        for (size_t r = 0; r < rounds; ++r)
+            for (const auto& kv : m)
+                sum_m += kv.second;
+    }, n * rounds);
+    double iter_f = time_ns([&] {
+        for (size_t r = 0; r < rounds; ++r)
+            for (const auto& kv : f)
+                sum_f += kv.second;
+    }, n * rounds);
+
+    cout << setw(8) << name << setw(9) << n << fixed << setprecision(1)
+         << setw(10) << build_m << setw(10) << build_f
+         << setw(10) << find_m << setw(10) << find_f
+         << setw(10) << iter_m << setw(10) << iter_f
+         << (sum_m == sum_f ? "" : "  MISMATCH") << endl;
+}
+
+int main()
+{
+    flat_map<string, int> fsi{{"foo", 42}, {"bar", 81}, {"bazzo", 4}, {"foo", 1}};
+    for (const auto& kv : fsi)
+        cout << kv << ' ';
+    cout << endl; // [bar, 81] [bazzo, 4] [foo, 42]
+
+    fsi.insert({{"qux", 7}, {"bar", 0}, {"alpha", 3}});
+    fsi["zeta"] += 2;
+    cout << fsi.size() << " keys, first " << fsi.begin()->first << ", bar "
+         << fsi.at("bar") << ", last " << fsi.rbegin()->first << endl; // 6 keys, first alpha, bar 81, last zeta
+
+    flat_set<int> fs{5, 3, 3, 1, 4};
+    cout << "flat_set: ";
+    for (int x : fs)
+        cout << x << ' ';
+    cout << "count(2) " << fs.count(2) << endl; // 1 3 4 5 count(2) 0
+
+    // values in a std::vector<bool>, reached through its bit proxies
+    flat_map<int, bool> seen{{3, false}, {1, false}};
+    seen[3] = true;
+    seen.find(1)->second = !seen.at(1);
+    seen[2];
+    for (const auto& kv : seen)
+        cout << kv << ' ';
+    cout << endl; // [1, 1] [2, 0] [3, 1]
+
+    /////////////////////////////////////////////////////////
+    cout << "ns per element: build from unsorted, find (half misses), iterate"
+         << endl;
+    cout << setw(8) << "key" << setw(9) << "n"
+         << setw(10) << "map" << setw(10) << "flat"
+         << setw(10) << "map" << setw(10) << "flat"
+         << setw(10) << "map" << setw(10) << "flat" << endl;
+    for (size_t n : { 100, 10000, 1000000 })
+        compare<int>("int", n);
+    for (size_t n : { 100, 10000, 1000000 })
+        compare<string>("string", n);
+
+    /////////////////////////////////////////////////////////
+    const size_t base = 100000, batch = 10000;
+    vector<pair<int, int>> more;
+    for (size_t i = 0; i < batch; ++i)
+        more.emplace_back(make_key<int>(base + i), int(i));
+    vector<pair<int, int>> start;
+    for (size_t i = 0; i < base; ++i)
+        start.emplace_back(make_key<int>(i), int(i));
+    flat_map<int, int> one(start.begin(), start.end()), batched(one);
+    double t_one = time_ns([&] {
+        for (const auto& kv : more)
+            one.insert(kv);
+    }, batch);
+    double t_batch = time_ns([&] { batched.insert(more.begin(), more.end()); }, batch);
+    cout << batch << " inserts into " << base << " keys, ns per key: one at a time "
+         << setprecision(1) << t_one << ", batched " << t_batch
+         << (one == batched ? "" : ", MISMATCH") << endl;
+}
@@ -0,0 +1,543 @@
+//
+//  flat_map.h
+//
+//  Created on 10/19/26.
+//  https://en.cppreference.com/w/cpp/container/flat_map
+//  https://arxiv.org/abs/1509.05053
+//
+//  Ordered containers in sorted arrays. flat_map keeps its keys in one
+//  vector and its values in another, so a lookup only reads keys packed
+//  next to each other and iteration walks memory in order. The binary
+//  search over numbers and pointers is branch-free: every step advances by
+//  half the range times the result of one comparison, so the loop runs
+//  log2(n) times whatever the keys are and there is no branch to
+//  mispredict. Building from unsorted input sorts once, and a batch of
+//  insertions is sorted and merged in a single pass instead of shifting
+//  the arrays once per key.
+//
+//  The template parameters read as std::map's, so print_container in
+//  variadic_templates.cpp takes a flat_map<std::string, int> the same way
+//  it takes a map<std::string, int>.
+
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Constructor tag for input that is already sorted and free of duplicates
+struct sorted_unique_t { };
+const sorted_unique_t sorted_unique = sorted_unique_t();
+
+namespace flat_map_detail {
+
+// Keys compared in a register or two take the branch-free search.
+// Anything dearer, std::string for one, searches with branches: there the
+// processor guessing the next step overlaps it with the current compare,
+// where the branch-free loop would have to wait for every compare in turn.
+template<typename Key>
+struct branch_free : std::integral_constant<bool,
+    std::is_arithmetic<Key>::value || std::is_pointer<Key>::value> { };
+
+template<typename Key, typename K, typename Compare>
+const Key* lower_bound(const Key* base, size_t n, const K& k, const Compare& comp,
+                       std::true_type) {
+    if (n == 0)
+        return base;
+    while (n > 1) {
+        size_t half = n / 2;
+        base += half * size_t(comp(base[half - 1], k));
+        n -= half;
+    }
+    return base + comp(*base, k);
+}
+
+template<typename Key, typename K, typename Compare>
+const Key* lower_bound(const Key* base, size_t n, const K& k, const Compare& comp,
+                       std::false_type) {
+    return std::lower_bound(base, base + n, k, comp);
+}
+
+template<typename Key, typename K, typename Compare>
+const Key* upper_bound(const Key* base, size_t n, const K& k, const Compare& comp,
+                       std::true_type) {
+    if (n == 0)
+        return base;
+    while (n > 1) {
+        size_t half = n / 2;
+        base += half * size_t(!comp(k, base[half - 1]));
+        n -= half;
+    }
+    return base + !comp(k, *base);
+}
+
+template<typename Key, typename K, typename Compare>
+const Key* upper_bound(const Key* base, size_t n, const K& k, const Compare& comp,
+                       std::false_type) {
+    return std::upper_bound(base, base + n, k, comp);
+}
+
+// First element not less than k
+template<typename Key, typename K, typename Compare>
+const Key* lower_bound(const Key* base, size_t n, const K& k, const Compare& comp) {
+    return lower_bound(base, n, k, comp, branch_free<Key>());
+}
+
+// First element greater than k
+template<typename Key, typename K, typename Compare>
+const Key* upper_bound(const Key* base, size_t n, const K& k, const Compare& comp) {
+    return upper_bound(base, n, k, comp, branch_free<Key>());
+}
+
+// Sorts by key and keeps the first of equal keys, as inserting them one
+// at a time would.
+template<typename T, typename KeyOf, typename Compare>
+void sort_unique(std::vector<T>& v, KeyOf key, const Compare& comp) {
+    std::stable_sort(v.begin(), v.end(), [&](const T& a, const T& b) {
+        return comp(key(a), key(b));
+    });
+    v.erase(std::unique(v.begin(), v.end(), [&](const T& a, const T& b) {
+        return !comp(key(a), key(b));
+    }), v.end());
+}
+
+struct identity {
+    template<typename T> const T& operator()(const T& t) const { return t; }
+};
+
+struct first {
+    template<typename T> auto operator()(const T& t) const
+        -> decltype((t.first)) { return t.first; }
+};
+
+} // namespace flat_map_detail
+
+////////////////////////////////////////////////////////////
+template<typename Key, typename T, typename Compare = std::less<Key>>
+class flat_map {
+    template<bool Const> class iter;
+
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<Key, T> value_type;
+    // T&, except for the bit proxy of std::vector<bool> when T is bool
+    typedef typename std::vector<T>::reference reference;
+    typedef typename std::vector<T>::const_reference const_reference;
+    typedef Compare key_compare;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef iter<false> iterator;
+    typedef iter<true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    flat_map() { }
+
+    explicit flat_map(const Compare& comp) : m_comp(comp) { }
+
+    // unsorted input with repeats allowed; the first of equal keys wins
+    template<typename InputIt>
+    flat_map(InputIt first, InputIt last, const Compare& comp = Compare())
+        : m_comp(comp) {
+        std::vector<value_type> batch(first, last);
+        flat_map_detail::sort_unique(batch, flat_map_detail::first(), m_comp);
+        assign_sorted(batch);
+    }
+
+    flat_map(std::initializer_list<value_type> l, const Compare& comp = Compare())
+        : flat_map(l.begin(), l.end(), comp) { }
+
+    // sorted, unique keys, taken as they are
+    flat_map(sorted_unique_t, std::vector<Key> keys, std::vector<T> values,
+             const Compare& comp = Compare())
+        : m_comp(comp), m_keys(std::move(keys)), m_values(std::move(values)) {
+        if (m_keys.size() != m_values.size())
+            throw std::invalid_argument("flat_map: key and value counts differ");
+    }
+
+    /////////////////////////////////////////////////////////
+    iterator begin() { return iterator(m_keys.data(), &m_values, 0); }
+    iterator end() { return begin() + difference_type(size()); }
+    const_iterator begin() const { return const_iterator(m_keys.data(), &m_values, 0); }
+    const_iterator end() const { return begin() + difference_type(size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_type size() const { return m_keys.size(); }
+    bool empty() const { return m_keys.empty(); }
+    void reserve(size_type n) { m_keys.reserve(n); m_values.reserve(n); }
+    void clear() { m_keys.clear(); m_values.clear(); }
+    key_compare key_comp() const { return m_comp; }
+
+    // the two arrays; values may be changed in place, keys may not
+    const std::vector<Key>& keys() const { return m_keys; }
+    const std::vector<T>& values() const { return m_values; }
+    std::vector<T>& values() { return m_values; }
+
+    /////////////////////////////////////////////////////////
+    iterator lower_bound(const Key& k) { return at_index(lower_index(k)); }
+    const_iterator lower_bound(const Key& k) const { return at_index(lower_index(k)); }
+    iterator upper_bound(const Key& k) { return at_index(upper_index(k)); }
+    const_iterator upper_bound(const Key& k) const { return at_index(upper_index(k)); }
+    std::pair<iterator, iterator> equal_range(const Key& k)
+        { return std::make_pair(lower_bound(k), upper_bound(k)); }
+    std::pair<const_iterator, const_iterator> equal_range(const Key& k) const
+        { return std::make_pair(lower_bound(k), upper_bound(k)); }
+
+    iterator find(const Key& k) { return at_index(find_index(k)); }
+    const_iterator find(const Key& k) const { return at_index(find_index(k)); }
+    size_type count(const Key& k) const { return find_index(k) != size(); }
+
+    reference at(const Key& k) {
+        size_t i = find_index(k);
+        if (i == size())
+            throw std::out_of_range("flat_map::at");
+        return m_values[i];
+    }
+    const_reference at(const Key& k) const {
+        size_t i = find_index(k);
+        if (i == size())
+            throw std::out_of_range("flat_map::at");
+        return m_values[i];
+    }
+
+    reference operator[](const Key& k) { return try_emplace(k).first.value(); }
+    reference operator[](Key&& k) { return try_emplace(std::move(k)).first.value(); }
+
+    /////////////////////////////////////////////////////////
+    // one key at a time shifts the arrays: O(n) per insertion
+    std::pair<iterator, bool> insert(const value_type& v)
+        { return try_emplace(v.first, v.second); }
+    std::pair<iterator, bool> insert(value_type&& v)
+        { return try_emplace(std::move(v.first), std::move(v.second)); }
+
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& k, Args&&... args) {
+        size_t i = lower_index(k);
+        if (i != size() && !m_comp(k, m_keys[i]))
+            return std::make_pair(at_index(i), false);
+        m_keys.emplace(m_keys.begin() + i, std::forward<K>(k));
+        try {
+            m_values.emplace(m_values.begin() + i, std::forward<Args>(args)...);
+        } catch (...) {
+            m_keys.erase(m_keys.begin() + i);
+            throw;
+        }
+        return std::make_pair(at_index(i), true);
+    }
+
+    // a batch is sorted and merged in one pass: O(n + m log m)
+    template<typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        std::vector<value_type> batch(first, last);
+        flat_map_detail::sort_unique(batch, flat_map_detail::first(), m_comp);
+        merge_sorted(batch);
+    }
+
+    void insert(std::initializer_list<value_type> l) { insert(l.begin(), l.end()); }
+
+    // keys already here keep their values, as with insert
+    void merge(const flat_map& other) {
+        std::vector<value_type> batch;
+        batch.reserve(other.size());
+        for (size_t i = 0; i < other.size(); ++i)
+            batch.emplace_back(other.m_keys[i], other.m_values[i]);
+        merge_sorted(batch);
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        size_t f = index_of(first), l = index_of(last);
+        m_keys.erase(m_keys.begin() + f, m_keys.begin() + l);
+        m_values.erase(m_values.begin() + f, m_values.begin() + l);
+        return at_index(f);
+    }
+
+    size_type erase(const Key& k) {
+        size_t i = find_index(k);
+        if (i == size())
+            return 0;
+        erase(at_index(i));
+        return 1;
+    }
+
+    void swap(flat_map& other) {
+        std::swap(m_comp, other.m_comp);
+        m_keys.swap(other.m_keys);
+        m_values.swap(other.m_values);
+    }
+
+    friend bool operator==(const flat_map& l, const flat_map& r)
+        { return l.m_keys == r.m_keys && l.m_values == r.m_values; }
+    friend bool operator!=(const flat_map& l, const flat_map& r) { return !(l == r); }
+
+private:
+    // Dereferences to a pair of references into the two arrays, so that
+    // it->first, it->second and range-for over pairs read as for std::map.
+    // The values are reached through their vector and an index rather
+    // than a pointer, as std::vector<bool> has no data() to point into.
+    template<bool Const>
+    class iter {
+        typedef typename std::conditional<Const, const std::vector<T>,
+                                          std::vector<T>>::type values_type;
+        typedef typename std::conditional<Const, const_reference,
+                                          typename flat_map::reference>::type mapped;
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef typename flat_map::value_type value_type;
+        typedef ptrdiff_t difference_type;
+        typedef std::pair<const Key&, mapped> reference;
+        struct pointer {
+            // it->second = x also assigns through the bit proxy of bool
+            mutable reference ref;
+            reference* operator->() const { return &ref; }
+        };
+
+        iter() : m_keys(nullptr), m_values(nullptr), m_i(0) { }
+        iter(const Key* keys, values_type* values, difference_type i)
+            : m_keys(keys), m_values(values), m_i(i) { }
+        // iterator converts to const_iterator
+        template<bool C, typename = typename std::enable_if<Const && !C>::type>
+        iter(const iter<C>& other)
+            : m_keys(other.m_keys), m_values(other.m_values), m_i(other.m_i) { }
+
+        const Key& key() const { return m_keys[m_i]; }
+        mapped value() const { return (*m_values)[m_i]; }
+
+        reference operator*() const { return reference(key(), value()); }
+        pointer operator->() const { return pointer{ **this }; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        iter& operator++() { ++m_i; return *this; }
+        iter& operator--() { --m_i; return *this; }
+        iter operator++(int) { iter t(*this); ++*this; return t; }
+        iter operator--(int) { iter t(*this); --*this; return t; }
+        iter& operator+=(difference_type n) { m_i += n; return *this; }
+        iter& operator-=(difference_type n) { m_i -= n; return *this; }
+        friend iter operator+(iter it, difference_type n) { return it += n; }
+        friend iter operator+(difference_type n, iter it) { return it += n; }
+        friend iter operator-(iter it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const iter& a, const iter& b)
+            { return a.m_i - b.m_i; }
+
+        friend bool operator==(const iter& a, const iter& b) { return a.m_i == b.m_i; }
+        friend bool operator!=(const iter& a, const iter& b) { return a.m_i != b.m_i; }
+        friend bool operator<(const iter& a, const iter& b) { return a.m_i < b.m_i; }
+        friend bool operator>(const iter& a, const iter& b) { return a.m_i > b.m_i; }
+        friend bool operator<=(const iter& a, const iter& b) { return a.m_i <= b.m_i; }
+        friend bool operator>=(const iter& a, const iter& b) { return a.m_i >= b.m_i; }
+
+    private:
+        friend class flat_map;
+        template<bool> friend class iter;
+        const Key* m_keys;
+        values_type* m_values;
+        difference_type m_i;
+    };
+
+    size_t lower_index(const Key& k) const {
+        return flat_map_detail::lower_bound(m_keys.data(), size(), k, m_comp) - m_keys.data();
+    }
+
+    size_t upper_index(const Key& k) const {
+        return flat_map_detail::upper_bound(m_keys.data(), size(), k, m_comp) - m_keys.data();
+    }
+
+    // size() when absent
+    size_t find_index(const Key& k) const {
+        size_t i = lower_index(k);
+        return i != size() && !m_comp(k, m_keys[i]) ? i : size();
+    }
+
+    iterator at_index(size_t i) { return begin() + difference_type(i); }
+    const_iterator at_index(size_t i) const { return begin() + difference_type(i); }
+    size_t index_of(const_iterator it) const { return size_t(it.m_i); }
+
+    void assign_sorted(std::vector<value_type>& batch) {
+        m_keys.clear();
+        m_values.clear();
+        reserve(batch.size());
+        for (value_type& v : batch) {
+            m_keys.push_back(std::move(v.first));
+            m_values.push_back(std::move(v.second));
+        }
+    }
+
+    // batch: sorted, unique; merged into fresh arrays front to back
+    void merge_sorted(std::vector<value_type>& batch) {
+        if (batch.empty())
+            return;
+        std::vector<Key> keys;
+        std::vector<T> values;
+        keys.reserve(size() + batch.size());
+        values.reserve(size() + batch.size());
+        size_t i = 0, j = 0;
+        while (i < size() || j < batch.size()) {
+            if (j == batch.size() || (i < size() && !m_comp(batch[j].first, m_keys[i]))) {
+                // equal keys: the one already here stays
+                if (j < batch.size() && !m_comp(m_keys[i], batch[j].first))
+                    ++j;
+                keys.push_back(std::move(m_keys[i]));
+                values.push_back(std::move(m_values[i]));
+                ++i;
+            } else {
+                keys.push_back(std::move(batch[j].first));
+                values.push_back(std::move(batch[j].second));
+                ++j;
+            }
+        }
+        m_keys.swap(keys);
+        m_values.swap(values);
+    }
+
+    Compare m_comp;
+    std::vector<Key> m_keys;
+    std::vector<T> m_values;
+};
+
+////////////////////////////////////////////////////////////
+template<typename Key, typename Compare = std::less<Key>>
+class flat_set {
+public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename std::vector<Key>::const_iterator const_iterator;
+    typedef const_iterator iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef const_reverse_iterator reverse_iterator;
+
+    flat_set() { }
+
+    explicit flat_set(const Compare& comp) : m_comp(comp) { }
+
+    template<typename InputIt>
+    flat_set(InputIt first, InputIt last, const Compare& comp = Compare())
+        : m_comp(comp), m_keys(first, last) {
+        flat_map_detail::sort_unique(m_keys, flat_map_detail::identity(), m_comp);
+    }
+
+    flat_set(std::initializer_list<Key> l, const Compare& comp = Compare())
+        : flat_set(l.begin(), l.end(), comp) { }
+
+    flat_set(sorted_unique_t, std::vector<Key> keys, const Compare& comp = Compare())
+        : m_comp(comp), m_keys(std::move(keys)) { }
+
+    /////////////////////////////////////////////////////////
+    const_iterator begin() const { return m_keys.begin(); }
+    const_iterator end() const { return m_keys.end(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    const_reverse_iterator rbegin() const { return m_keys.rbegin(); }
+    const_reverse_iterator rend() const { return m_keys.rend(); }
+
+    size_type size() const { return m_keys.size(); }
+    bool empty() const { return m_keys.empty(); }
+    void reserve(size_type n) { m_keys.reserve(n); }
+    void clear() { m_keys.clear(); }
+    key_compare key_comp() const { return m_comp; }
+    const std::vector<Key>& keys() const { return m_keys; }
+
+    const_iterator lower_bound(const Key& k) const {
+        return begin() + (flat_map_detail::lower_bound(m_keys.data(), size(), k, m_comp)
+                          - m_keys.data());
+    }
+    const_iterator upper_bound(const Key& k) const {
+        return begin() + (flat_map_detail::upper_bound(m_keys.data(), size(), k, m_comp)
+                          - m_keys.data());
+    }
+    std::pair<const_iterator, const_iterator> equal_range(const Key& k) const
+        { return std::make_pair(lower_bound(k), upper_bound(k)); }
+
+    const_iterator find(const Key& k) const {
+        const_iterator it = lower_bound(k);
+        return it != end() && !m_comp(k, *it) ? it : end();
+    }
+    size_type count(const Key& k) const { return find(k) != end(); }
+
+    /////////////////////////////////////////////////////////
+    std::pair<iterator, bool> insert(const Key& k) { return emplace(k); }
+    std::pair<iterator, bool> insert(Key&& k) { return emplace(std::move(k)); }
+
+    template<typename K>
+    std::pair<iterator, bool> emplace(K&& k) {
+        const_iterator it = lower_bound(k);
+        if (it != end() && !m_comp(k, *it))
+            return std::make_pair(it, false);
+        return std::make_pair(m_keys.insert(it, std::forward<K>(k)), true);
+    }
+
+    template<typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        std::vector<Key> batch(first, last);
+        flat_map_detail::sort_unique(batch, flat_map_detail::identity(), m_comp);
+        merge_sorted(batch);
+    }
+
+    void insert(std::initializer_list<Key> l) { insert(l.begin(), l.end()); }
+
+    void merge(const flat_set& other) {
+        std::vector<Key> batch(other.m_keys);
+        merge_sorted(batch);
+    }
+
+    iterator erase(const_iterator pos) { return m_keys.erase(pos); }
+    iterator erase(const_iterator first, const_iterator last)
+        { return m_keys.erase(first, last); }
+
+    size_type erase(const Key& k) {
+        const_iterator it = find(k);
+        if (it == end())
+            return 0;
+        m_keys.erase(it);
+        return 1;
+    }
+
+    void swap(flat_set& other) {
+        std::swap(m_comp, other.m_comp);
+        m_keys.swap(other.m_keys);
+    }
+
+    friend bool operator==(const flat_set& l, const flat_set& r) { return l.m_keys == r.m_keys; }
+    friend bool operator!=(const flat_set& l, const flat_set& r) { return !(l == r); }
+
+private:
+    void merge_sorted(std::vector<Key>& batch) {
+        if (batch.empty())
+            return;
+        std::vector<Key> keys;
+        keys.reserve(size() + batch.size());
+        size_t i = 0, j = 0;
+        while (i < size() || j < batch.size()) {
+            if (j == batch.size() || (i < size() && !m_comp(batch[j], m_keys[i]))) {
+                if (j < batch.size() && !m_comp(m_keys[i], batch[j]))
+                    ++j;
+                keys.push_back(std::move(m_keys[i++]));
+            } else {
+                keys.push_back(std::move(batch[j++]));
+            }
+        }
+        m_keys.swap(keys);
+    }
+
+    Compare m_comp;
+    std::vector<Key> m_keys;
+};
+
+#endif
@@ -0,0 +1,371 @@
+//
+//  format.h
+//
+//  Created on 10/19/26.
+//  http://en.cppreference.com/w/cpp/utility/format/spec
+//  https://www.zverovich.net/2020/05/21/reducing-printf-calls.html
+//
+//  Format strings compiled at compile time. FMT("[{}, {}]") turns the
+//  literal into a type whose conststr is parsed by constexpr functions;
+//  format_to() checks the fields against the argument types and expands
+//  into one append per literal piece and one writer call per field, all
+//  into a reusable format_buffer. Nothing about the format is looked at
+//  while the program runs.
+//
+//  Fields are {} or {name}, optionally followed by a spec after ':'
+//    {}  {x:}   the value as operator<< would print it
+//    {:x}       an integer in hexadecimal
+//    {:.3}      a floating point number with 3 decimals
+//  {{ and }} stand for braces. The name only documents the field; fields
+//  take the arguments in order. Other types are formatted by a
+//  format_value(format_buffer&, const T&) found by argument-dependent
+//  lookup.
+
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "conststr.h"
+#include "indices.h"
+
+// A format literal as a type: FMT("{} = {}")
+#define FMT(s) ([] { \
+        struct format_string { \
+            static constexpr conststr str() { return s; } \
+        }; \
+        return format_string(); \
+    }())
+
+////////////////////////////////////////////////////////////
+// Output; clear() keeps the memory for the next line
+class format_buffer {
+public:
+    explicit format_buffer(size_t capacity = 256)
+        : m_data(capacity), m_size(0) { }
+
+    const char* data() const { return m_data.data(); }
+    size_t size() const { return m_size; }
+    std::string str() const { return std::string(data(), m_size); }
+    void clear() { m_size = 0; }
+
+    void append(const char* s, size_t n) {
+        std::memcpy(reserve(n), s, n);
+        m_size += n;
+    }
+
+    void push_back(char c) {
+        *reserve(1) = c;
+        ++m_size;
+    }
+
+    // room for n more characters; commit what was written with commit()
+    char* reserve(size_t n) {
+        if (m_data.size() - m_size < n)
+            m_data.resize(std::max(m_data.size() * 2, m_size + n));
+        return &m_data[m_size];
+    }
+
+    void commit(size_t n) { m_size += n; }
+
+private:
+    std::vector<char> m_data;
+    size_t m_size;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const format_buffer& b) {
+    return os.write(b.data(), std::streamsize(b.size()));
+}
+
+////////////////////////////////////////////////////////////
+// Writers for built-in types, matching the default ostream output
+inline void format_value(format_buffer& out, const char* s) {
+    out.append(s, std::strlen(s));
+}
+
+inline void format_value(format_buffer& out, const std::string& s) {
+    out.append(s.data(), s.size());
+}
+
+inline void format_value(format_buffer& out, char c) { out.push_back(c); }
+inline void format_value(format_buffer& out, signed char c) { out.push_back(char(c)); }
+inline void format_value(format_buffer& out, unsigned char c) { out.push_back(char(c)); }
+inline void format_value(format_buffer& out, bool b) { out.push_back(b ? '1' : '0'); }
+
+namespace fmt_detail {
+
+template<typename T> struct is_number : std::integral_constant<bool,
+    std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+    !std::is_same<T, char>::value && !std::is_same<T, signed char>::value &&
+    !std::is_same<T, unsigned char>::value> { };
+
+template<typename T>
+typename std::make_unsigned<T>::type magnitude(T v, std::true_type /*signed*/) {
+    typedef typename std::make_unsigned<T>::type U;
+    return v < 0 ? U(0) - U(v) : U(v);
+}
+
+template<typename T>
+T magnitude(T v, std::false_type) { return v; }
+
+template<typename T>
+bool is_negative(T v, std::true_type /*signed*/) { return v < 0; }
+
+template<typename T>
+bool is_negative(T, std::false_type) { return false; }
+
+template<typename U>
+void write_decimal(format_buffer& out, U u, bool negative) {
+    static const char digits[] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char tmp[24];
+    char* p = tmp + sizeof(tmp);
+    while (u >= 100) {
+        const char* d = digits + u % 100 * 2;
+        u /= 100;
+        *--p = d[1];
+        *--p = d[0];
+    }
+    if (u >= 10) {
+        *--p = digits[u * 2 + 1];
+        *--p = digits[u * 2];
+    } else {
+        *--p = char('0' + u);
+    }
+    if (negative)
+        *--p = '-';
+    out.append(p, size_t(tmp + sizeof(tmp) - p));
+}
+
+template<typename U>
+void write_hex(format_buffer& out, U u) {
+    char tmp[2 * sizeof(U)];
+    char* p = tmp + sizeof(tmp);
+    do {
+        *--p = "0123456789abcdef"[u & 0xf];
+        u >>= 4;
+    } while (u);
+    out.append(p, size_t(tmp + sizeof(tmp) - p));
+}
+
+template<typename T>
+void write_float(format_buffer& out, T v, int precision) {
+    const char* fmt = std::is_same<T, long double>::value ?
+        (precision < 0 ? "%Lg" : "%.*Lf") : (precision < 0 ? "%g" : "%.*f");
+    char* p = out.reserve(64);
+    int n = precision < 0 ? std::snprintf(p, 64, fmt, v) :
+                            std::snprintf(p, 64, fmt, precision, v);
+    if (n >= 64) { // very large fixed-point numbers
+        p = out.reserve(size_t(n) + 1);
+        n = precision < 0 ? std::snprintf(p, size_t(n) + 1, fmt, v) :
+                            std::snprintf(p, size_t(n) + 1, fmt, precision, v);
+    }
+    out.commit(size_t(n));
+}
+
+} // namespace fmt_detail
+
+template<typename T>
+typename std::enable_if<fmt_detail::is_number<T>::value>::type
+format_value(format_buffer& out, T v) {
+    fmt_detail::write_decimal(out, fmt_detail::magnitude(v, std::is_signed<T>()),
+                              fmt_detail::is_negative(v, std::is_signed<T>()));
+}
+
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type
+format_value(format_buffer& out, T v) {
+    fmt_detail::write_float(out, v, -1);
+}
+
+inline void format_value(format_buffer& out, const void* p) {
+    if (!p) {
+        out.push_back('0');
+        return;
+    }
+    out.append("0x", 2);
+    fmt_detail::write_hex(out, uintptr_t(p));
+}
+
+////////////////////////////////////////////////////////////
+// Parsing; s[i] is always the first character of a token. Malformed
+// formats throw, which inside a constant expression is a compile error.
+namespace fmt_detail {
+
+enum token_kind { literal, escape, field, };
+enum spec_kind { spec_none, spec_hex, spec_fixed, };
+
+constexpr size_t literal_end(conststr s, size_t i) {
+    return i == s.size() || s[i] == '{' || s[i] == '}' ? i : literal_end(s, i + 1);
+}
+
+constexpr size_t field_end(conststr s, size_t i) {
+    return i == s.size() ? throw std::invalid_argument("format: '{' without '}'") :
+           s[i] == '{' ? throw std::invalid_argument("format: '{' inside a field") :
+           s[i] == '}' ? i : field_end(s, i + 1);
+}
+
+constexpr token_kind kind_at(conststr s, size_t i) {
+    return s[i] == '{' ? (i + 1 < s.size() && s[i + 1] == '{' ? escape : field) :
+           s[i] == '}' ? (i + 1 < s.size() && s[i + 1] == '}' ? escape :
+                          throw std::invalid_argument("format: '}' without '{'")) :
+           literal;
+}
+
+constexpr size_t token_next(conststr s, size_t i) {
+    return kind_at(s, i) == escape ? i + 2 :
+           kind_at(s, i) == field ? field_end(s, i + 1) + 1 :
+           literal_end(s, i);
+}
+
+// the characters a literal or escape token writes: [i, text_end)
+constexpr size_t text_end(conststr s, size_t i) {
+    return kind_at(s, i) == escape ? i + 1 : literal_end(s, i);
+}
+
+constexpr size_t token_count(conststr s, size_t i = 0, size_t n = 0) {
+    return i == s.size() ? n : token_count(s, token_next(s, i), n + 1);
+}
+
+constexpr size_t token_start(conststr s, size_t t, size_t i = 0) {
+    return t == 0 ? i : token_start(s, t - 1, token_next(s, i));
+}
+
+// fields among the first t tokens
+constexpr size_t fields_before(conststr s, size_t t, size_t i = 0, size_t n = 0) {
+    return t == 0 ? n :
+           fields_before(s, t - 1, token_next(s, i), n + (kind_at(s, i) == field));
+}
+
+constexpr size_t field_count(conststr s) {
+    return fields_before(s, token_count(s));
+}
+
+// the spec of the field starting at i: after ':' and before '}'
+constexpr size_t spec_begin(conststr s, size_t i) {
+    return s[i] == '}' ? i : s[i] == ':' ? i + 1 : spec_begin(s, i + 1);
+}
+
+constexpr int digits_value(conststr s, size_t i, int v = 0) {
+    return s[i] == '}' ? v :
+           s[i] >= '0' && s[i] <= '9' ? digits_value(s, i + 1, v * 10 + (s[i] - '0')) :
+           throw std::invalid_argument("format: bad precision");
+}
+
+constexpr spec_kind spec_at(conststr s, size_t b) {
+    return s[b] == '}' ? spec_none :
+           s[b] == 'x' && s[b + 1] == '}' ? spec_hex :
+           s[b] == '.' && s[b + 1] != '}' && digits_value(s, b + 1) >= 0 ? spec_fixed :
+           throw std::invalid_argument("format: unknown spec");
+}
+
+constexpr int precision_at(conststr s, size_t b) {
+    return spec_at(s, b) == spec_fixed ? digits_value(s, b + 1) : -1;
+}
+
+template<typename T>
+class is_formattable {
+    template<typename U>
+    static auto test(int) -> decltype(
+        format_value(std::declval<format_buffer&>(), std::declval<const U&>()),
+        std::true_type());
+    template<typename U>
+    static std::false_type test(...);
+public:
+    enum { value = decltype(test<T>(0))::value, };
+};
+
+////////////////////////////////////////////////////////////
+// Writers for one token
+template<spec_kind Spec, int Precision> struct field_writer {
+    template<typename T>
+    static void write(format_buffer& out, const T& v) {
+        static_assert(is_formattable<T>::value,
+                      "format: no format_value() for this argument type");
+        format_value(out, v);
+    }
+};
+
+template<int Precision> struct field_writer<spec_hex, Precision> {
+    template<typename T>
+    static void write(format_buffer& out, const T& v) {
+        static_assert(std::is_integral<T>::value,
+                      "format: {:x} needs an integer argument");
+        // make_unsigned<bool> is ill-formed: bool goes through unsigned and
+        // prints 0 or 1, as with {}; so do non-integers, after the assert
+        typedef typename std::conditional<std::is_integral<T>::value &&
+            !std::is_same<T, bool>::value, T, unsigned>::type int_type;
+        write_hex(out, typename std::make_unsigned<int_type>::type(v));
+    }
+};
+
+template<int Precision> struct field_writer<spec_fixed, Precision> {
+    template<typename T>
+    static void write(format_buffer& out, const T& v) {
+        static_assert(std::is_floating_point<T>::value,
+                      "format: {:.N} needs a floating point argument");
+        write_float(out, v, Precision);
+    }
+};
+
+template<typename Fmt, size_t Start, token_kind Kind = kind_at(Fmt::str(), Start)>
+struct token_writer {
+    template<size_t T, typename Tuple>
+    static void write(format_buffer& out, const Tuple&) {
+        out.append(Fmt::str().data() + Start, text_end(Fmt::str(), Start) - Start);
+    }
+};
+
+template<typename Fmt, size_t Start>
+struct token_writer<Fmt, Start, field> {
+    template<size_t T, typename Tuple>
+    static void write(format_buffer& out, const Tuple& args) {
+        const size_t b = spec_begin(Fmt::str(), Start + 1);
+        field_writer<spec_at(Fmt::str(), b), precision_at(Fmt::str(), b)>::write(
+            out, std::get<fields_before(Fmt::str(), T)>(args));
+    }
+};
+
+template<typename Fmt, size_t... Ts, typename... Args>
+void write_tokens(format_buffer& out, indices<Ts...>, const Args&... args) {
+    std::tuple<const Args&...> refs(args...);
+    int expand[] = { 0,
+        (token_writer<Fmt, token_start(Fmt::str(), Ts)>::template
+            write<Ts>(out, refs), 0)... };
+    (void)expand;
+    (void)refs;
+}
+
+} // namespace fmt_detail
+
+////////////////////////////////////////////////////////////
+// Appends the formatted arguments to out:
+//   format_to(buf, FMT("[{}, {}]"), p.first, p.second);
+template<typename Fmt, typename... Args>
+void format_to(format_buffer& out, Fmt, const Args&... args) {
+    static_assert(fmt_detail::field_count(Fmt::str()) == sizeof...(Args),
+                  "format: the number of fields and of arguments differ");
+    fmt_detail::write_tokens<Fmt>(out, make_indices<
+        fmt_detail::token_count(Fmt::str())>(), args...);
+}
+
+template<typename Fmt, typename... Args>
+std::string format(Fmt f, const Args&... args) {
+    format_buffer out;
+    format_to(out, f, args...);
+    return out.str();
+}
+
+#endif
@@ -0,0 +1,45 @@
+//
+//  hash_bytes.h
+//
+//  Created on 10/19/26.
+//  https://probablydance.com/2018/06/16/fibonacci-hashing-the-optimization-that-the-world-forgot-or-a-better-alternative-to-integer-modulo/
+//
+//  The string hash shared by hash_map.h and string_pool.h: the bytes are
+//  read eight at a time and each word is folded in with one multiply by
+//  2^64 / golden ratio. Both headers pull the two functions into their
+//  own detail namespace.
+
+#ifndef HASH_BYTES_H
+#define HASH_BYTES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hash_detail {
+
+inline uint64_t mix(uint64_t x) {
+    // multiply by 2^64 / golden ratio, fold the high half into the low
+    x *= 0x9E3779B97F4A7C15ull;
+    return x ^ (x >> 32);
+}
+
+// Reads the string eight bytes at a time.
+inline uint64_t hash_bytes(const char* p, size_t len) {
+    uint64_t h = mix(len);
+    for (; len >= 8; p += 8, len -= 8) {
+        uint64_t w;
+        std::memcpy(&w, p, 8);
+        h = mix(h ^ w);
+    }
+    if (len > 0) {
+        uint64_t w = 0;
+        std::memcpy(&w, p, len);
+        h = mix(h ^ w);
+    }
+    return h;
+}
+
+} // namespace hash_detail
+
+#endif
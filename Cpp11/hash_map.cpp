@@ -0,0 +1,109 @@
+//
+//  hash_map.cpp
+//
+//  Created on 10/19/26.
+//
+//  hash_map.h in use, and flat_hash_map against std::unordered_map for
+//  integer, floating point, pointer, string and big_integer keys.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "big_integer.h"
+#include "hash_map.h"
+
+using namespace std;
+
+////////////////////////////////////////////////////////////
+// Benchmark against std::unordered_map
+template<typename Map, typename K>
+double time_map(const vector<K>& keys, const vector<K>& misses, size_t& hits) {
+    auto start = chrono::steady_clock::now();
+    Map m;
+    for (size_t i = 0; i < keys.size(); ++i)
+        m[keys[i]] = int(i);
+    for (const auto& k : keys)
+        hits += m.count(k);
+    for (const auto& k : misses)
+        hits += m.count(k);
+    for (size_t i = 0; i < keys.size(); i += 2)
+        m.erase(keys[i]);
+    for (const auto& k : keys)
+        hits += m.count(k);
+    chrono::duration<double, milli> ms = chrono::steady_clock::now() - start;
+    return ms.count();
+}
+
+template<typename K>
+void bench(const char* name, const vector<K>& keys, const vector<K>& misses) {
+    size_t hits_std = 0, hits_flat = 0;
+    double t_std = time_map<unordered_map<K, int>>(keys, misses, hits_std);
+    double t_flat = time_map<flat_hash_map<K, int>>(keys, misses, hits_flat);
+    cout << setw(12) << name << setw(10) << keys.size()
+         << setw(14) << fixed << setprecision(1) << t_std
+         << setw(14) << t_flat
+         << setw(9) << setprecision(2) << t_std / t_flat << "x"
+         << (hits_std == hits_flat ? "" : "  MISMATCH") << endl;
+}
+
+int main()
+{
+    cout << hex;
+    cout << hash_of(123) << endl;
+    cout << hash_of(0.0) << ' ' << hash_of(-0.0) << endl; // equal
+    cout << hash_of("123") << ' ' << hash_of(string("123")) << endl; // equal
+    cout << hash_of(big_integer("123")) << endl;
+    cout << dec;
+
+    flat_hash_map<string, int> msi;
+    msi["foo"] = 42;
+    msi["bar"] = 81;
+    msi["bazzo"] = 4;
+    msi.erase("bar");
+    for (const auto& v : msi)
+        cout << "[" << v.first << ", " << v.second << "] ";
+    cout << endl;
+    cout << "count(foo) = " << msi.count("foo")
+         << " count(bar) = " << msi.count("bar") << endl;
+
+    /////////////////////////////////////////////////////////
+    const size_t n = 1 << 20;
+    mt19937_64 rng(42);
+    vector<int> ki, mi;
+    vector<double> kd, md;
+    vector<int*> kp, mp;
+    vector<string> ks, ms;
+    vector<big_integer> kb, mb;
+    vector<int> storage(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+        ki.push_back(int(rng() >> 33));
+        mi.push_back(-int(rng() >> 33) - 1);
+        kd.push_back(double(rng() >> 11) / (1ull << 53));
+        md.push_back(-double(rng() >> 11) / (1ull << 53) - 1);
+        kp.push_back(&storage[i]);
+        mp.push_back(&storage[n + i]);
+        ks.push_back("user:" + to_string(rng() % 100000000) + ":session");
+        ms.push_back("miss:" + to_string(rng() % 100000000) + ":session");
+        // 20 to 30 digits, three or four limbs
+        string digits = to_string(rng() >> 1) + to_string(rng() % 1000000000);
+        kb.push_back(big_integer(digits));
+        mb.push_back(big_integer("-" + digits));
+    }
+    // look keys up in an order unrelated to their addresses
+    shuffle(kp.begin(), kp.end(), rng);
+    shuffle(mp.begin(), mp.end(), rng);
+
+    cout << setw(12) << "key" << setw(10) << "n"
+         << setw(14) << "unordered ms" << setw(14) << "flat ms"
+         << setw(10) << "speedup" << endl;
+    bench("int", ki, mi);
+    bench("double", kd, md);
+    bench("pointer", kp, mp);
+    bench("string", ks, ms);
+    bench("big_integer", kb, mb);
+}
@@ -0,0 +1,416 @@
+//
+//  hash_map.h
+//
+//  Created on 10/19/26.
+//  https://abseil.io/about/design/swisstables
+//  https://probablydance.com/2018/06/16/fibonacci-hashing-the-optimization-that-the-world-forgot-or-a-better-alternative-to-integer-modulo/
+//
+//  Hash functions picked by the same enable_if / integral_trait
+//  classification as enable_if.cpp and type_traits.cpp, and an
+//  open-addressing hash map that probes 16 control bytes at a time.
+
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "hash_bytes.h"
+#include "integral_trait.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace hash_map_detail {
+
+using hash_detail::mix;
+using hash_detail::hash_bytes;
+
+template<typename T> struct pointee_align
+    { enum { value = 1, }; };
+template<typename T> struct pointee_align<T*>
+    { enum { value = std::is_object<T>::value ? std::alignment_of<
+          typename std::conditional<std::is_object<T>::value, T, char>::type>::value
+          : 1, }; };
+
+template<size_t N> struct log2_of
+    { enum { value = 1 + log2_of<N / 2>::value, }; };
+template<> struct log2_of<1>
+    { enum { value = 0, }; };
+
+} // namespace hash_map_detail
+
+////////////////////////////////////////////////////////////
+// Hash functions, one per kind of type
+template<typename T,
+    typename std::enable_if<std::is_integral<T>::value, int>::type n = 0>
+uint64_t hash_of(T t) {
+    return hash_map_detail::mix(static_cast<uint64_t>(t));
+}
+
+template<typename T,
+    typename std::enable_if<std::is_floating_point<T>::value, int>::type n = 0>
+uint64_t hash_of(T t) {
+    // -0.0 == +0.0, so they must hash alike
+    if (t == 0)
+        t = 0;
+    uint64_t bits = 0;
+    std::memcpy(&bits, &t, sizeof(T) < sizeof(bits) ? sizeof(T) : sizeof(bits));
+    return hash_map_detail::mix(bits);
+}
+
+template<typename T,
+    typename std::enable_if<std::is_pointer<T>::value, int>::type n = 0>
+uint64_t hash_of(T t) {
+    using namespace hash_map_detail;
+    // the low bits of an aligned pointer are always zero
+    return mix(reinterpret_cast<uintptr_t>(t) >>
+               log2_of<pointee_align<T>::value>::value);
+}
+
+inline uint64_t hash_of(const std::string& s) {
+    return hash_map_detail::hash_bytes(s.data(), s.size());
+}
+
+// A C string hashes by its characters, as the std::string it spells
+// does, not by its address as other pointers do.
+inline uint64_t hash_of(const char* s) {
+    return hash_map_detail::hash_bytes(s, std::strlen(s));
+}
+
+inline uint64_t hash_of(char* s) {
+    return hash_of(static_cast<const char*>(s));
+}
+
+// User types registered with integral_trait supply hash_value() found by
+// argument-dependent lookup.
+template<typename T,
+    typename std::enable_if<!std::is_arithmetic<T>::value &&
+                            integral_trait<T>::is_integral, int>::type n = 0>
+uint64_t hash_of(const T& t) {
+    return hash_map_detail::mix(hash_value(t));
+}
+
+template<typename T>
+struct fast_hash {
+    size_t operator()(const T& t) const { return hash_of(t); }
+};
+
+////////////////////////////////////////////////////////////
+namespace hash_map_detail {
+
+// Control bytes: one per slot, 16 per group
+typedef int8_t ctrl_t;
+const ctrl_t ctrl_empty = -128;  // 0b10000000
+const ctrl_t ctrl_deleted = -2;  // 0b11111110
+// a full slot holds the low 7 bits of its hash: 0b0xxxxxxx
+
+const size_t group_width = 16;
+
+#if defined(__SSE2__)
+struct group {
+    __m128i ctrl;
+    explicit group(const ctrl_t* p)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) { }
+
+    uint32_t match(ctrl_t h2) const {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl));
+    }
+    uint32_t match_empty() const { return match(ctrl_empty); }
+    // empty and deleted are the only bytes with the sign bit set
+    uint32_t match_free() const { return _mm_movemask_epi8(ctrl); }
+};
+#else
+struct group {
+    const ctrl_t* ctrl;
+    explicit group(const ctrl_t* p) : ctrl(p) { }
+
+    uint32_t match(ctrl_t h2) const {
+        uint32_t m = 0;
+        for (size_t i = 0; i < group_width; ++i)
+            m |= uint32_t(ctrl[i] == h2) << i;
+        return m;
+    }
+    uint32_t match_empty() const { return match(ctrl_empty); }
+    uint32_t match_free() const {
+        uint32_t m = 0;
+        for (size_t i = 0; i < group_width; ++i)
+            m |= uint32_t(ctrl[i] < 0) << i;
+        return m;
+    }
+};
+#endif
+
+} // namespace hash_map_detail
+
+////////////////////////////////////////////////////////////
+// Open-addressing hash map with flat slot storage.
+// Keys must not be modified through iterators.
+template<typename K, typename V,
+         typename Hash = fast_hash<K>, typename Eq = std::equal_to<K>>
+class flat_hash_map {
+    typedef hash_map_detail::ctrl_t ctrl_t;
+    typedef hash_map_detail::group group;
+
+public:
+    typedef std::pair<K, V> value_type;
+
+    template<typename Value>
+    class basic_iterator {
+    public:
+        basic_iterator(const ctrl_t* c, Value* s, const ctrl_t* e)
+            : m_ctrl(c), m_slot(s), m_end(e) { skip_free(); }
+
+        Value& operator*() const { return *m_slot; }
+        Value* operator->() const { return m_slot; }
+        basic_iterator& operator++() {
+            ++m_ctrl; ++m_slot; skip_free();
+            return *this;
+        }
+        bool operator==(const basic_iterator& o) const
+            { return m_ctrl == o.m_ctrl; }
+        bool operator!=(const basic_iterator& o) const
+            { return m_ctrl != o.m_ctrl; }
+    private:
+        void skip_free() {
+            while (m_ctrl != m_end && *m_ctrl < 0) { ++m_ctrl; ++m_slot; }
+        }
+        const ctrl_t* m_ctrl;
+        Value* m_slot;
+        const ctrl_t* m_end;
+    };
+    typedef basic_iterator<value_type> iterator;
+    typedef basic_iterator<const value_type> const_iterator;
+
+    flat_hash_map() : m_ctrl(nullptr), m_slots(nullptr), m_capacity(0),
+        m_size(0), m_growth_left(0) { }
+
+    flat_hash_map(const flat_hash_map& other) : flat_hash_map() {
+        reserve(other.size());
+        for (const auto& v : other)
+            insert(v);
+    }
+
+    flat_hash_map(flat_hash_map&& other) : flat_hash_map() { swap(other); }
+
+    flat_hash_map& operator=(flat_hash_map other) {
+        swap(other);
+        return *this;
+    }
+
+    ~flat_hash_map() {
+        destroy_slots();
+        deallocate(m_ctrl, m_slots, m_capacity);
+    }
+
+    void swap(flat_hash_map& other) {
+        std::swap(m_ctrl, other.m_ctrl);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growth_left, other.m_growth_left);
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    size_t capacity() const { return m_capacity; }
+
+    iterator begin()
+        { return iterator(m_ctrl, m_slots, m_ctrl + m_capacity); }
+    iterator end()
+        { return iterator(m_ctrl + m_capacity, m_slots + m_capacity,
+                          m_ctrl + m_capacity); }
+    const_iterator begin() const
+        { return const_iterator(m_ctrl, m_slots, m_ctrl + m_capacity); }
+    const_iterator end() const
+        { return const_iterator(m_ctrl + m_capacity, m_slots + m_capacity,
+                                m_ctrl + m_capacity); }
+
+    iterator find(const K& key) {
+        size_t i = find_index(key);
+        return i == npos ? end() : at_index(i);
+    }
+    const_iterator find(const K& key) const {
+        size_t i = find_index(key);
+        return i == npos ? end()
+            : const_iterator(m_ctrl + i, m_slots + i, m_ctrl + m_capacity);
+    }
+    size_t count(const K& key) const { return find_index(key) != npos; }
+
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(const K& key, Args&&... args) {
+        size_t h = Hash()(key);
+        size_t i = find_index(key, h);
+        if (i != npos)
+            return std::make_pair(at_index(i), false);
+        i = prepare_insert(h);
+        // the slot only counts as full once the pair is built, so a
+        // throwing constructor leaves the map as it was
+        ::new (m_slots + i) value_type(std::piecewise_construct,
+            std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        commit_insert(i, h);
+        return std::make_pair(at_index(i), true);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& v)
+        { return emplace(v.first, v.second); }
+
+    V& operator[](const K& key) { return emplace(key).first->second; }
+
+    size_t erase(const K& key) {
+        size_t i = find_index(key);
+        if (i == npos)
+            return 0;
+        m_slots[i].~value_type();
+        --m_size;
+        // probing stops at a group with an empty byte, so a slot in such
+        // a group can become empty again; otherwise leave a tombstone
+        size_t g = i & ~(hash_map_detail::group_width - 1);
+        if (group(m_ctrl + g).match_empty()) {
+            m_ctrl[i] = hash_map_detail::ctrl_empty;
+            ++m_growth_left;
+        } else {
+            m_ctrl[i] = hash_map_detail::ctrl_deleted;
+        }
+        return 1;
+    }
+
+    void clear() {
+        destroy_slots();
+        if (m_capacity)
+            std::memset(m_ctrl, hash_map_detail::ctrl_empty, m_capacity);
+        m_size = 0;
+        m_growth_left = max_load(m_capacity);
+    }
+
+    void reserve(size_t n) {
+        size_t cap = hash_map_detail::group_width;
+        while (max_load(cap) < n)
+            cap *= 2;
+        if (cap > m_capacity)
+            rehash(cap);
+    }
+
+private:
+    static const size_t npos = size_t(-1);
+
+    // at most 7/8 of the slots are used before growing
+    static size_t max_load(size_t cap) { return cap - cap / 8; }
+
+    static ctrl_t h2(size_t h) { return ctrl_t(h & 0x7f); }
+
+    iterator at_index(size_t i)
+        { return iterator(m_ctrl + i, m_slots + i, m_ctrl + m_capacity); }
+
+    size_t find_index(const K& key) const
+        { return find_index(key, Hash()(key)); }
+
+    // Visits groups in triangular order, which covers every group when
+    // the number of groups is a power of two.
+    size_t find_index(const K& key, size_t h) const {
+        if (m_capacity == 0)
+            return npos;
+        const size_t width = hash_map_detail::group_width;
+        size_t mask = m_capacity / width - 1;
+        size_t g = (h >> 7) & mask;
+        for (size_t step = 1; ; ++step) {
+            group grp(m_ctrl + g * width);
+            for (uint32_t m = grp.match(h2(h)); m; m &= m - 1) {
+                size_t i = g * width + __builtin_ctz(m);
+                if (Eq()(m_slots[i].first, key))
+                    return i;
+            }
+            if (grp.match_empty())
+                return npos;
+            g = (g + step) & mask;
+        }
+    }
+
+    size_t find_free(size_t h) const {
+        const size_t width = hash_map_detail::group_width;
+        size_t mask = m_capacity / width - 1;
+        size_t g = (h >> 7) & mask;
+        for (size_t step = 1; ; ++step) {
+            uint32_t m = group(m_ctrl + g * width).match_free();
+            if (m)
+                return g * width + __builtin_ctz(m);
+            g = (g + step) & mask;
+        }
+    }
+
+    // a free slot for hash h, growing the table first if it is full
+    size_t prepare_insert(size_t h) {
+        size_t i = m_capacity ? find_free(h) : 0;
+        if (m_growth_left == 0 &&
+            (m_capacity == 0 || m_ctrl[i] != hash_map_detail::ctrl_deleted)) {
+            // tombstones alone filling the table only need a cleanup
+            rehash(m_size * 2 < max_load(m_capacity) ? m_capacity
+                   : m_capacity ? m_capacity * 2 : hash_map_detail::group_width);
+            i = find_free(h);
+        }
+        return i;
+    }
+
+    // marks slot i, now holding a constructed pair, as full
+    void commit_insert(size_t i, size_t h) {
+        if (m_ctrl[i] == hash_map_detail::ctrl_empty)
+            --m_growth_left;
+        m_ctrl[i] = h2(h);
+        ++m_size;
+    }
+
+    void rehash(size_t cap) {
+        ctrl_t* old_ctrl = m_ctrl;
+        value_type* old_slots = m_slots;
+        size_t old_cap = m_capacity;
+
+        allocate(cap);
+        for (size_t i = 0; i < old_cap; ++i) {
+            if (old_ctrl[i] < 0)
+                continue;
+            size_t h = Hash()(old_slots[i].first);
+            size_t j = find_free(h);
+            m_ctrl[j] = h2(h);
+            ::new (m_slots + j) value_type(std::move(old_slots[i]));
+            old_slots[i].~value_type();
+        }
+        m_growth_left = max_load(cap) - m_size;
+        deallocate(old_ctrl, old_slots, old_cap);
+    }
+
+    void allocate(size_t cap) {
+        m_ctrl = new ctrl_t[cap];
+        std::memset(m_ctrl, hash_map_detail::ctrl_empty, cap);
+        m_slots = std::allocator<value_type>().allocate(cap);
+        m_capacity = cap;
+    }
+
+    static void deallocate(ctrl_t* ctrl, value_type* slots, size_t cap) {
+        delete[] ctrl;
+        if (slots)
+            std::allocator<value_type>().deallocate(slots, cap);
+    }
+
+    void destroy_slots() {
+        for (size_t i = 0; i < m_capacity; ++i)
+            if (m_ctrl[i] >= 0)
+                m_slots[i].~value_type();
+    }
+
+    ctrl_t* m_ctrl;
+    value_type* m_slots;
+    size_t m_capacity;
+    size_t m_size;
+    size_t m_growth_left;
+};
+
+#endif
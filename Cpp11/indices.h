@@ -0,0 +1,41 @@
+//
+//  indices.h
+//
+//  Created on 10/19/26.
+//  http://en.cppreference.com/w/cpp/utility/integer_sequence
+//
+//  indices<0, 1, ..., N - 1>, what std::index_sequence is in C++14, for
+//  the headers that expand a tuple, an array or a list of tokens by
+//  position. The names differ from the standard ones on purpose: with
+//  using namespace std under C++14 the two would be ambiguous.
+//
+//  make_indices<N> derives from indices<0, ..., N - 1>, so an argument
+//  make_indices<N>() deduces Is... in a parameter indices<Is...>. It
+//  splits N in halves, keeping the instantiation depth at log2(N) where
+//  counting down one at a time would reach the default limit of 900 with
+//  the 1000-type lists of typelist.cpp; equal halves are instantiated
+//  once.
+
+#ifndef INDICES_H
+#define INDICES_H
+
+#include <cstddef>
+
+template<std::size_t... Is> struct indices {
+    typedef indices type;
+};
+
+template<class L, class R> struct concat_indices;
+
+template<std::size_t... L, std::size_t... R>
+struct concat_indices<indices<L...>, indices<R...>>
+    : indices<L..., (sizeof...(L) + R)...> { };
+
+template<std::size_t N> struct make_indices
+    : concat_indices<typename make_indices<N / 2>::type,
+                     typename make_indices<N - N / 2>::type> { };
+
+template<> struct make_indices<0> : indices<> { };
+template<> struct make_indices<1> : indices<0> { };
+
+#endif
@@ -0,0 +1,119 @@
+//
+//  inplace_function.cpp
+//
+//  Created on 10/19/26.
+//
+//  inplace_function.h in use, and what it costs against function pointers
+//  and std::function: heap allocations and time to build a vector of
+//  callbacks with small and larger captures, and the time per call when
+//  the callbacks run.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include "inplace_function.h"
+
+using namespace std;
+
+// counts heap allocations, see string_pool.cpp
+static atomic<size_t> allocations(0);
+
+void* operator new(size_t n) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(n))
+        return p;
+    throw bad_alloc();
+}
+
+// out of line, or GCC sees free() on what operator new returned and warns
+__attribute__((noinline)) void operator delete(void* p) noexcept { free(p); }
+
+template<typename F>
+double time_ns(F f, size_t ops) {
+    auto start = chrono::steady_clock::now();
+    f();
+    chrono::duration<double, nano> ns = chrono::steady_clock::now() - start;
+    return ns.count() / double(ops);
+}
+
+int add_one(int x) { return x + 1; }
+
+// three captured values: 24 bytes, past std::function's 16 inline bytes
+struct scaled {
+    long a, b, c;
+    int operator()(int x) const { return int(a * x + b - c); }
+};
+
+const size_t n = 1 << 16;
+const int rounds = 32;
+
+template<typename Callback, typename Make>
+void row(const string& name, Make make) {
+    vector<Callback> v(n); // touched once, so the build below is not paging
+    v.clear();
+    size_t before = allocations;
+    double build = time_ns([&] {
+        for (size_t i = 0; i < n; ++i)
+            v.push_back(make(i));
+    }, n);
+    double per = double(allocations - before) / n;
+    long sum = 0;
+    double call = time_ns([&] {
+        for (int r = 0; r < rounds; ++r)
+            for (const Callback& f : v)
+                sum += f(r);
+    }, n * rounds);
+    cout << setw(38) << name << fixed << setprecision(2) << setw(12) << per
+         << setw(10) << build << setw(10) << call
+         << (sum == 0 ? " (sum 0)" : "") << endl;
+}
+
+int main()
+{
+    inplace_function<int(int)> f(add_one);
+    cout << "f(1) = " << f(1) << ", sizeof " << sizeof(f) << ", capacity "
+         << f.capacity() << endl; // 2, 48, 32
+    int base = 40;
+    f = [base](int x) { return base + x; };
+    cout << "f(2) = " << f(2) << endl; // 42
+
+    unique_ptr<string> owned(new string("moved in"));
+    move_only_inplace_function<size_t(), 16> g(bind([](const unique_ptr<string>& s) {
+        return s->size();
+    }, std::move(owned)));
+    move_only_inplace_function<size_t(), 16> h(std::move(g));
+    cout << "move-only capture: " << h() << ", source empty " << (g == nullptr)
+         << ", copyable " << is_copy_constructible<decltype(h)>::value
+         << endl; // 8, 1, 0
+    // inplace_function<int(int), 16> big(scaled{1, 2, 3}); // does not compile
+    // inplace_function<size_t(), 16> copy(std::move(h)); // neither does this
+
+    f = nullptr;
+    try {
+        f(0);
+    } catch (const bad_function_call&) {
+        cout << "empty call throws bad_function_call" << endl;
+    }
+
+    /////////////////////////////////////////////////////////
+    cout << n << " callbacks, each called " << rounds << " times" << endl;
+    cout << setw(38) << "callback" << setw(12) << "allocs each" << setw(10)
+         << "build ns" << setw(10) << "call ns" << endl;
+    row<int (*)(int)>("function pointer", [](size_t) { return &add_one; });
+    row<function<int(int)>>("std::function, 8 byte capture",
+        [](size_t i) { long k = long(i); return [k](int x) { return int(x + k); }; });
+    row<inplace_function<int(int)>>("inplace_function, 8 byte capture",
+        [](size_t i) { long k = long(i); return [k](int x) { return int(x + k); }; });
+    row<function<int(int)>>("std::function, 24 byte capture",
+        [](size_t i) { return scaled{ long(i), 2, 3 }; });
+    row<inplace_function<int(int)>>("inplace_function, 24 byte capture",
+        [](size_t i) { return scaled{ long(i), 2, 3 }; });
+}
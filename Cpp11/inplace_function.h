@@ -0,0 +1,275 @@
+//
+//  inplace_function.h
+//
+//  Created on 10/19/26.
+//  http://en.cppreference.com/w/cpp/utility/functional/function
+//  http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2016/p0032r3.pdf
+//
+//  A std::function that never allocates. inplace_function<int(T), 32>
+//  keeps the callable in 32 bytes of its own storage; a lambda whose
+//  captures do not fit is rejected at compile time instead of spilling to
+//  the heap. Like std::function it only takes callables it can copy; a
+//  move-only one, such as a lambda owning a unique_ptr, goes in a
+//  move_only_inplace_function, which has no copy constructor. Calls go
+//  through one pointer in a per-type table, and when the callable is
+//  trivially copyable, as function pointers and lambdas capturing plain
+//  values are, moving and copying are a memcpy of the storage and
+//  destruction does nothing.
+
+#ifndef INPLACE_FUNCTION_H
+#define INPLACE_FUNCTION_H
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace inplace_function_detail {
+
+// What the callable of type F does, reached through one pointer
+template<typename R, typename... Args>
+struct vtable {
+    R (*invoke)(void* f, Args&&... args);
+    bool trivial;                                // memcpy to copy or move, no destructor
+    void (*copy)(void* to, const void* from);    // nullptr if F is move-only
+    void (*relocate)(void* to, void* from);      // move to `to`, destroy `from`
+    void (*destroy)(void* f);
+};
+
+template<typename R>
+struct invoker {
+    template<typename F, typename... Args>
+    static R call(F& f, Args&&... args) { return f(std::forward<Args>(args)...); }
+};
+
+template<>
+struct invoker<void> {
+    template<typename F, typename... Args>
+    static void call(F& f, Args&&... args) { f(std::forward<Args>(args)...); }
+};
+
+template<typename F, bool Copyable = std::is_copy_constructible<F>::value>
+struct copier {
+    static void copy(void* to, const void* from)
+        { ::new (to) F(*static_cast<const F*>(from)); }
+};
+
+template<typename F>
+struct copier<F, false> {
+    static constexpr void (*copy)(void*, const void*) = nullptr;
+};
+
+template<typename F, typename R, typename... Args>
+struct vtable_for {
+    static R invoke(void* f, Args&&... args)
+        { return invoker<R>::call(*static_cast<F*>(f), std::forward<Args>(args)...); }
+    static void relocate(void* to, void* from) {
+        F* src = static_cast<F*>(from);
+        ::new (to) F(std::move(*src));
+        src->~F();
+    }
+    static void destroy(void* f) { static_cast<F*>(f)->~F(); }
+
+    static const vtable<R, Args...> value;
+};
+
+template<typename F, typename R, typename... Args>
+const vtable<R, Args...> vtable_for<F, R, Args...>::value = {
+    &vtable_for::invoke,
+    std::is_trivially_copyable<F>::value,
+    copier<F>::copy,
+    &vtable_for::relocate,
+    &vtable_for::destroy,
+};
+
+// An empty function: calling it throws, like calling an empty std::function
+template<typename R, typename... Args>
+struct empty_vtable {
+    static R invoke(void*, Args&&...) { throw std::bad_function_call(); }
+    static const vtable<R, Args...> value;
+};
+
+template<typename R, typename... Args>
+const vtable<R, Args...> empty_vtable<R, Args...>::value = {
+    &empty_vtable::invoke, true, nullptr, nullptr, nullptr,
+};
+
+// f(args...) is well formed and converts to R
+template<typename F, typename R, typename... Args>
+struct callable {
+    template<typename G>
+    static auto test(int) -> decltype(std::declval<G&>()(std::declval<Args>()...),
+                                      std::true_type());
+    template<typename G>
+    static std::false_type test(...);
+
+    template<typename G, bool = decltype(test<G>(0))::value>
+    struct returns : std::false_type { };
+    template<typename G>
+    struct returns<G, true> : std::integral_constant<bool, std::is_void<R>::value ||
+        std::is_convertible<decltype(std::declval<G&>()(std::declval<Args>()...)), R>::value> { };
+
+    enum { value = returns<F>::value, };
+};
+
+// a null function pointer makes an empty function
+template<typename T> struct nullable : std::false_type { };
+template<typename R, typename... A> struct nullable<R (*)(A...)> : std::true_type { };
+
+template<typename F>
+bool is_null(F f, std::true_type) { return f == nullptr; }
+template<typename F>
+bool is_null(const F&, std::false_type) { return false; }
+
+// what the copy constructor of a move-only function takes instead of
+// itself, so that it has none: the move constructor deletes the implicit one
+struct not_copyable { };
+
+} // namespace inplace_function_detail
+
+////////////////////////////////////////////////////////////
+template<typename Sig, size_t Capacity = 32,
+         size_t Align = alignof(std::max_align_t), bool Copyable = true>
+class inplace_function;
+
+template<typename Sig, size_t Capacity = 32,
+         size_t Align = alignof(std::max_align_t)>
+using move_only_inplace_function = inplace_function<Sig, Capacity, Align, false>;
+
+template<typename R, typename... Args, size_t Capacity, size_t Align, bool Copyable>
+class inplace_function<R(Args...), Capacity, Align, Copyable> {
+    typedef inplace_function_detail::vtable<R, Args...> vtable;
+    typedef typename std::conditional<Copyable, const inplace_function&,
+        const inplace_function_detail::not_copyable&>::type copy_source;
+
+    template<typename F>
+    using enable_for = typename std::enable_if<
+        !std::is_same<typename std::decay<F>::type, inplace_function>::value &&
+        inplace_function_detail::callable<typename std::decay<F>::type, R, Args...>::value
+    >::type;
+
+public:
+    typedef R result_type;
+
+    inplace_function() : m_vtable(empty()) { }
+    inplace_function(std::nullptr_t) : m_vtable(empty()) { }
+
+    template<typename F, typename = enable_for<F>>
+    inplace_function(F&& f) : m_vtable(empty()) {
+        typedef typename std::decay<F>::type functor;
+        static_assert(sizeof(functor) <= Capacity,
+                      "inplace_function: the callable does not fit, raise Capacity");
+        static_assert(Align % alignof(functor) == 0,
+                      "inplace_function: the callable needs a stricter Align");
+        static_assert(std::is_nothrow_move_constructible<functor>::value,
+                      "inplace_function: the callable must be nothrow movable");
+        static_assert(!Copyable || std::is_copy_constructible<functor>::value,
+                      "inplace_function: the callable is move-only, "
+                      "use move_only_inplace_function");
+        if (inplace_function_detail::is_null<functor>(f,
+                inplace_function_detail::nullable<functor>()))
+            return;
+        ::new (&m_storage) functor(std::forward<F>(f));
+        m_vtable = &inplace_function_detail::vtable_for<functor, R, Args...>::value;
+    }
+
+    inplace_function(copy_source other) : m_vtable(empty()) {
+        copy_from(other);
+    }
+
+    inplace_function(inplace_function&& other) noexcept : m_vtable(empty()) {
+        move_from(other);
+    }
+
+    ~inplace_function() { reset(); }
+
+    inplace_function& operator=(copy_source other) {
+        if (this != &other) {
+            inplace_function tmp(other);
+            reset();
+            move_from(tmp);
+        }
+        return *this;
+    }
+
+    inplace_function& operator=(inplace_function&& other) noexcept {
+        if (this != &other) {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    inplace_function& operator=(std::nullptr_t) {
+        reset();
+        return *this;
+    }
+
+    template<typename F, typename = enable_for<F>>
+    inplace_function& operator=(F&& f) {
+        return *this = inplace_function(std::forward<F>(f));
+    }
+
+    void swap(inplace_function& other) noexcept {
+        inplace_function tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    explicit operator bool() const { return m_vtable != empty(); }
+
+    // throws std::bad_function_call when empty
+    R operator()(Args... args) const {
+        return m_vtable->invoke(&m_storage, std::forward<Args>(args)...);
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    friend bool operator==(const inplace_function& f, std::nullptr_t) { return !f; }
+    friend bool operator==(std::nullptr_t, const inplace_function& f) { return !f; }
+    friend bool operator!=(const inplace_function& f, std::nullptr_t) { return bool(f); }
+    friend bool operator!=(std::nullptr_t, const inplace_function& f) { return bool(f); }
+
+private:
+    static const vtable* empty() {
+        return &inplace_function_detail::empty_vtable<R, Args...>::value;
+    }
+
+    void reset() {
+        if (!m_vtable->trivial)
+            m_vtable->destroy(&m_storage);
+        m_vtable = empty();
+    }
+
+    // *this is empty
+    void copy_from(const inplace_function& other) {
+        if (other.m_vtable->trivial)
+            std::memcpy(&m_storage, &other.m_storage, Capacity);
+        else
+            other.m_vtable->copy(&m_storage, &other.m_storage);
+        m_vtable = other.m_vtable;
+    }
+
+    // *this is empty; other is left empty
+    void move_from(inplace_function& other) noexcept {
+        if (other.m_vtable->trivial)
+            std::memcpy(&m_storage, &other.m_storage, Capacity);
+        else
+            other.m_vtable->relocate(&m_storage, &other.m_storage);
+        m_vtable = other.m_vtable;
+        other.m_vtable = empty();
+    }
+
+    mutable typename std::aligned_storage<Capacity, Align>::type m_storage;
+    const vtable* m_vtable;
+};
+
+template<typename Sig, size_t Capacity, size_t Align, bool Copyable>
+void swap(inplace_function<Sig, Capacity, Align, Copyable>& a,
+          inplace_function<Sig, Capacity, Align, Copyable>& b) noexcept {
+    a.swap(b);
+}
+
+#endif
@@ -0,0 +1,25 @@
+//
+//  integral_trait.h
+//
+//  Created on 10/19/26.
+//  https://segmentfault.com/a/1190000003901666
+//
+//  integral_trait from type_traits.cpp, shared with hash_map.h. A class
+//  that behaves like an integer, big_integer for one, registers itself by
+//  specializing integral_trait next to its definition.
+
+#ifndef INTEGRAL_TRAIT_H
+#define INTEGRAL_TRAIT_H
+
+template<typename T> struct integral_trait
+    { enum { is_integral = false, }; };
+template<> struct integral_trait<char>
+    { enum { is_integral = true, }; };
+template<> struct integral_trait<unsigned char>
+    { enum { is_integral = true, }; };
+template<> struct integral_trait<int>
+    { enum { is_integral = true, }; };
+template<> struct integral_trait<unsigned int>
+    { enum { is_integral = true, }; };
+
+#endif
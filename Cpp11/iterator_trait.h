@@ -0,0 +1,108 @@
+//
+//  iterator_trait.h
+//
+//  Created on 10/19/26.
+//  https://segmentfault.com/a/1190000003901666
+//
+//  iterator_trait from type_traits.cpp, extended to tell contiguous
+//  storage (built-in arrays, vector, array, string) apart from node-based
+//  containers, and to expose the element type and a data() pointer for
+//  the contiguous ones.
+
+#ifndef ITERATOR_TRAIT_H
+#define ITERATOR_TRAIT_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include <array>
+#include <string>
+
+template<typename T>
+struct iterator_trait {
+    typedef typename T::iterator iterator;
+    typedef typename T::value_type value_type;
+    enum { is_contiguous = false, };
+    static iterator begin(T& c) { return c.begin(); }
+    static iterator end(T& c) { return c.end(); }
+};
+
+template<typename T>
+struct iterator_trait<const T> {
+    typedef typename T::const_iterator iterator;
+    typedef typename T::value_type value_type;
+    enum { is_contiguous = iterator_trait<T>::is_contiguous, };
+    static iterator begin(const T& c) { return c.begin(); }
+    static iterator end(const T& c) { return c.end(); }
+    static const value_type* data(const T& c) { return c.data(); }
+    static size_t size(const T& c) { return c.size(); }
+};
+
+template<typename T, size_t N>
+struct iterator_trait<T[N]> {
+    typedef T* iterator;
+    typedef T value_type;
+    enum { is_contiguous = true, };
+    static iterator begin(T arr[N]) { return arr; }
+    static iterator end(T arr[N]) { return arr + N; }
+    static T* data(T arr[N]) { return arr; }
+    static size_t size(T*) { return N; }
+};
+
+template<typename T, size_t N>
+struct iterator_trait<const T[N]> {
+    typedef const T* iterator;
+    typedef T value_type;
+    enum { is_contiguous = true, };
+    static iterator begin(const T arr[N]) { return arr; }
+    static iterator end(const T arr[N]) { return arr + N; }
+    static const T* data(const T arr[N]) { return arr; }
+    static size_t size(const T*) { return N; }
+};
+
+// Containers that store their elements in one array.
+template<typename T>
+struct contiguous_trait {
+    typedef typename T::iterator iterator;
+    typedef typename T::value_type value_type;
+    enum { is_contiguous = true, };
+    static iterator begin(T& c) { return c.begin(); }
+    static iterator end(T& c) { return c.end(); }
+    static value_type* data(T& c) { return c.data(); }
+    static size_t size(T& c) { return c.size(); }
+};
+
+template<typename T, typename A>
+struct iterator_trait<std::vector<T, A>>
+    : contiguous_trait<std::vector<T, A>> { };
+
+// vector<bool> packs bits and has no data()
+template<typename A>
+struct iterator_trait<std::vector<bool, A>> {
+    typedef typename std::vector<bool, A>::iterator iterator;
+    typedef bool value_type;
+    enum { is_contiguous = false, };
+    static iterator begin(std::vector<bool, A>& c) { return c.begin(); }
+    static iterator end(std::vector<bool, A>& c) { return c.end(); }
+};
+
+template<typename T, size_t N>
+struct iterator_trait<std::array<T, N>>
+    : contiguous_trait<std::array<T, N>> { };
+
+// basic_string::data() is const until C++17
+template<typename C, typename Tr, typename A>
+struct iterator_trait<std::basic_string<C, Tr, A>>
+    : contiguous_trait<std::basic_string<C, Tr, A>> {
+    static C* data(std::basic_string<C, Tr, A>& s) { return &s[0]; }
+};
+
+// Contiguous ranges of trivially copyable elements can be moved around
+// with memcpy/memset instead of element by element.
+template<typename T, typename Trait = iterator_trait<T>>
+struct is_bulk_copyable {
+    enum { value = Trait::is_contiguous && std::is_trivially_copyable<
+        typename Trait::value_type>::value, };
+};
+
+#endif
@@ -0,0 +1,111 @@
+//
+//  range_algorithms.cpp
+//
+//  Created on 10/19/26.
+//
+//  Benchmark matrix for range_algorithms.h: arrays, vectors, deques and
+//  lists of int32_t, float and double, each operation timed through the
+//  element-by-element path and through the dispatching one.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <chrono>
+#include "range_algorithms.h"
+
+using namespace std;
+
+const size_t N = 1 << 16;
+
+template<typename F>
+double ns_per_elem(F f) {
+    const int reps = 50;
+    f(); // warm up
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < reps; ++i)
+        f();
+    chrono::duration<double, nano> ns = chrono::steady_clock::now() - start;
+    return ns.count() / reps / N;
+}
+
+// keeps results alive so the timed loops are not optimized away
+volatile double g_sink;
+
+template<typename C>
+void run(const char* name, C& a, C& b) {
+    typedef typename iterator_trait<C>::value_type T;
+    typedef typename iterator_trait<C>::iterator iterator;
+    for (iterator i = iterator_trait<C>::begin(a), j = iterator_trait<C>::begin(b);
+            i != iterator_trait<C>::end(a); ++i, ++j)
+        *i = *j = T(int(distance(iterator_trait<C>::begin(a), i) % 1000));
+    const T missing = T(-1);
+
+    double t[6][2];
+    t[0][0] = ns_per_elem([&] { bulk::generic::copy(a, b); });
+    t[0][1] = ns_per_elem([&] { bulk::copy(a, b); });
+    t[1][0] = ns_per_elem([&] { bulk::generic::fill(b, 7); });
+    t[1][1] = ns_per_elem([&] { bulk::fill(b, 7); });
+    bulk::copy(a, b);
+    t[2][0] = ns_per_elem([&] { g_sink = bulk::generic::equal(a, b); });
+    t[2][1] = ns_per_elem([&] { g_sink = bulk::equal(a, b); });
+    t[3][0] = ns_per_elem([&] {
+        g_sink = bulk::generic::find(a, missing) == iterator_trait<const C>::end(a); });
+    t[3][1] = ns_per_elem([&] {
+        g_sink = bulk::find(a, missing) == iterator_trait<const C>::end(a); });
+    t[4][0] = ns_per_elem([&] { g_sink = bulk::generic::sum(a); });
+    t[4][1] = ns_per_elem([&] { g_sink = bulk::sum(a); });
+    t[5][0] = ns_per_elem([&] { g_sink = bulk::generic::minmax(a).second; });
+    t[5][1] = ns_per_elem([&] { g_sink = bulk::minmax(a).second; });
+
+    cout << setw(16) << name;
+    for (int op = 0; op < 6; ++op)
+        cout << setw(7) << fixed << setprecision(2) << t[op][0]
+             << "/" << left << setw(5) << t[op][1] << right;
+    cout << endl;
+}
+
+template<typename T>
+void run_all(const char* type) {
+    static T arr_a[N], arr_b[N];
+    vector<T> vec_a(N), vec_b(N);
+    deque<T> deq_a(N), deq_b(N);
+    list<T> lst_a(N), lst_b(N);
+
+    run((string("array ") + type).c_str(), arr_a, arr_b);
+    run((string("vector ") + type).c_str(), vec_a, vec_b);
+    run((string("deque ") + type).c_str(), deq_a, deq_b);
+    run((string("list ") + type).c_str(), lst_a, lst_b);
+}
+
+int main()
+{
+    int arr_i[] = { 3, 1, 4, 1, 5, 9, 2, 6, 5, 3 };
+    vector<float> vec_f(arr_i, arr_i + 10);
+    list<double> lst_d(arr_i, arr_i + 10);
+    string str = "hello, world";
+
+    cout << "sum(arr_i) = " << bulk::sum(arr_i) << endl;        // 39
+    cout << "max(vec_f) = " << bulk::max(vec_f) << endl;        // 9
+    cout << "min(lst_d) = " << bulk::min(lst_d) << endl;        // 1
+    cout << "find(str, 'w') at "
+         << bulk::find(str, 'w') - str.begin() << endl;         // 7
+    cout << "find(arr_i, 2.5) at "
+         << bulk::find(arr_i, 2.5) - arr_i << endl;             // 10
+    cout << "equal(arr_i, vec_f) = " << bulk::equal(arr_i, vec_f) << endl; // 1
+    bulk::fill(vec_f, 0);
+    bulk::copy(vec_f, lst_d);
+    cout << "sum(lst_d) after copy = " << bulk::sum(lst_d) << endl; // 0
+
+    /////////////////////////////////////////////////////////
+    cout << "ns per element, element-by-element/dispatched, " << N
+         << " elements" << endl;
+    cout << setw(16) << "container" << setw(13) << "copy"
+         << setw(13) << "fill" << setw(13) << "equal" << setw(13) << "find"
+         << setw(13) << "sum" << setw(13) << "minmax" << endl;
+    run_all<int32_t>("int32_t");
+    run_all<float>("float");
+    run_all<double>("double");
+}
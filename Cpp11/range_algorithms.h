@@ -0,0 +1,434 @@
+//
+//  range_algorithms.h
+//
+//  Created on 10/19/26.
+//  https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html
+//
+//  copy, fill, equal, find, sum and min/max over whole containers.
+//  iterator_trait picks the implementation: memcpy/memset/memcmp for
+//  contiguous trivially copyable elements, SSE2 kernels for contiguous
+//  int32_t/float/double, and the element-by-element walk of print_each in
+//  type_traits.cpp for everything else (deque, list, ...).
+
+#ifndef RANGE_ALGORITHMS_H
+#define RANGE_ALGORITHMS_H
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#include "iterator_trait.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+////////////////////////////////////////////////////////////
+// SSE2 lanes, specialized per element type
+template<typename T> struct simd_ops
+    { enum { available = false, }; };
+
+#if defined(__SSE2__)
+template<> struct simd_ops<float> {
+    enum { available = true, lanes = 4, full_mask = 0xf, };
+    typedef __m128 reg;
+    static reg load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, reg r) { _mm_storeu_ps(p, r); }
+    static reg set1(float v) { return _mm_set1_ps(v); }
+    static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+    static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+    static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+    static int eq(reg a, reg b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+};
+
+template<> struct simd_ops<double> {
+    enum { available = true, lanes = 2, full_mask = 0x3, };
+    typedef __m128d reg;
+    static reg load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, reg r) { _mm_storeu_pd(p, r); }
+    static reg set1(double v) { return _mm_set1_pd(v); }
+    static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+    static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+    static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+    static int eq(reg a, reg b) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+};
+
+template<> struct simd_ops<int32_t> {
+    enum { available = true, lanes = 4, full_mask = 0xf, };
+    typedef __m128i reg;
+    static reg load(const int32_t* p)
+        { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(int32_t* p, reg r)
+        { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), r); }
+    static reg set1(int32_t v) { return _mm_set1_epi32(v); }
+    static reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+    // SSE2 has no 32-bit min/max; select with a compare mask
+    static reg select(reg m, reg a, reg b)
+        { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+    static reg min(reg a, reg b) { return select(_mm_cmplt_epi32(a, b), a, b); }
+    static reg max(reg a, reg b) { return select(_mm_cmpgt_epi32(a, b), a, b); }
+    static int eq(reg a, reg b)
+        { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+};
+#endif
+
+namespace bulk {
+
+////////////////////////////////////////////////////////////
+// Element-by-element versions; they work for any container
+namespace generic {
+
+template<typename Src, typename Dst>
+void copy(const Src& src, Dst& dst) {
+    typedef iterator_trait<const Src> S;
+    typedef iterator_trait<Dst> D;
+    typename D::iterator out = D::begin(dst);
+    for (typename S::iterator i = S::begin(src); i != S::end(src); ++i, ++out)
+        *out = *i;
+}
+
+template<typename C, typename V>
+void fill(C& c, const V& v) {
+    typedef iterator_trait<C> Trait;
+    for (typename Trait::iterator i = Trait::begin(c); i != Trait::end(c); ++i)
+        *i = v;
+}
+
+template<typename A, typename B>
+bool equal(const A& a, const B& b) {
+    typedef iterator_trait<const A> TA;
+    typedef iterator_trait<const B> TB;
+    typename TA::iterator i = TA::begin(a);
+    typename TB::iterator j = TB::begin(b);
+    for (; i != TA::end(a) && j != TB::end(b); ++i, ++j)
+        if (!(*i == *j))
+            return false;
+    return i == TA::end(a) && j == TB::end(b);
+}
+
+template<typename C, typename V>
+typename iterator_trait<const C>::iterator find(const C& c, const V& v) {
+    typedef iterator_trait<const C> Trait;
+    typename Trait::iterator i = Trait::begin(c);
+    for (; i != Trait::end(c); ++i)
+        if (*i == v)
+            break;
+    return i;
+}
+
+template<typename C>
+typename iterator_trait<const C>::value_type sum(const C& c) {
+    typedef iterator_trait<const C> Trait;
+    typename Trait::value_type s = typename Trait::value_type();
+    for (typename Trait::iterator i = Trait::begin(c); i != Trait::end(c); ++i)
+        s += *i;
+    return s;
+}
+
+// requires a non-empty container
+template<typename C>
+std::pair<typename iterator_trait<const C>::value_type,
+          typename iterator_trait<const C>::value_type>
+minmax(const C& c) {
+    typedef iterator_trait<const C> Trait;
+    typename Trait::iterator i = Trait::begin(c);
+    typename Trait::value_type lo = *i, hi = *i;
+    for (++i; i != Trait::end(c); ++i) {
+        if (*i < lo) lo = *i;
+        if (hi < *i) hi = *i;
+    }
+    return std::make_pair(lo, hi);
+}
+
+} // namespace generic
+
+////////////////////////////////////////////////////////////
+// Kernels over contiguous memory
+namespace kernel {
+
+template<typename T>
+T sum(const T* p, size_t n) {
+    typedef simd_ops<T> S;
+    const size_t L = S::lanes;
+    // four accumulators hide the latency of the adds
+    typename S::reg a0 = S::set1(T()), a1 = a0, a2 = a0, a3 = a0;
+    size_t i = 0;
+    for (; i + 4 * L <= n; i += 4 * L) {
+        a0 = S::add(a0, S::load(p + i));
+        a1 = S::add(a1, S::load(p + i + L));
+        a2 = S::add(a2, S::load(p + i + 2 * L));
+        a3 = S::add(a3, S::load(p + i + 3 * L));
+    }
+    T lanes[L];
+    S::store(lanes, S::add(S::add(a0, a1), S::add(a2, a3)));
+    T s = T();
+    for (size_t l = 0; l < L; ++l)
+        s += lanes[l];
+    for (; i < n; ++i)
+        s += p[i];
+    return s;
+}
+
+template<typename T>
+std::pair<T, T> minmax(const T* p, size_t n) {
+    typedef simd_ops<T> S;
+    const size_t L = S::lanes;
+    typename S::reg lo = S::set1(p[0]), hi = lo;
+    size_t i = 0;
+    for (; i + L <= n; i += L) {
+        typename S::reg v = S::load(p + i);
+        lo = S::min(lo, v);
+        hi = S::max(hi, v);
+    }
+    T l[L], h[L];
+    S::store(l, lo);
+    S::store(h, hi);
+    for (size_t k = 1; k < L; ++k) {
+        if (l[k] < l[0]) l[0] = l[k];
+        if (h[0] < h[k]) h[0] = h[k];
+    }
+    for (; i < n; ++i) {
+        if (p[i] < l[0]) l[0] = p[i];
+        if (h[0] < p[i]) h[0] = p[i];
+    }
+    return std::make_pair(l[0], h[0]);
+}
+
+template<typename T>
+size_t find(const T* p, size_t n, T v) {
+    typedef simd_ops<T> S;
+    const size_t L = S::lanes;
+    typename S::reg key = S::set1(v);
+    size_t i = 0;
+    for (; i + L <= n; i += L)
+        if (int m = S::eq(S::load(p + i), key))
+            return i + __builtin_ctz(m);
+    for (; i < n && !(p[i] == v); ++i)
+        ;
+    return i;
+}
+
+template<typename T>
+bool equal(const T* a, const T* b, size_t n) {
+    typedef simd_ops<T> S;
+    const size_t L = S::lanes;
+    size_t i = 0;
+    for (; i + L <= n; i += L)
+        if (S::eq(S::load(a + i), S::load(b + i)) != S::full_mask)
+            return false;
+    for (; i < n; ++i)
+        if (!(a[i] == b[i]))
+            return false;
+    return true;
+}
+
+template<typename T>
+void fill(T* p, size_t n, T v) {
+    typedef simd_ops<T> S;
+    const size_t L = S::lanes;
+    typename S::reg r = S::set1(v);
+    size_t body = n - n % L;
+    for (size_t i = 0; i < body; i += L)
+        S::store(p + i, r);
+    for (size_t i = body; i < n; ++i)
+        p[i] = v;
+}
+
+} // namespace kernel
+
+////////////////////////////////////////////////////////////
+// Dispatch: 0 walks elements, 1 uses mem* on contiguous storage,
+// 2 uses the SIMD kernels
+template<typename C, typename Trait = iterator_trait<C>>
+struct algorithm_kind {
+    typedef typename Trait::value_type value_type;
+    enum {
+        bulk = is_bulk_copyable<C>::value,
+        simd = Trait::is_contiguous && simd_ops<value_type>::available,
+        // == on these compares the object representation
+        bytewise = bulk && (std::is_integral<value_type>::value ||
+                            std::is_pointer<value_type>::value ||
+                            std::is_enum<value_type>::value),
+    };
+};
+
+template<int K> struct kind_tag { };
+
+// the calls below are qualified so that argument-dependent lookup does
+// not drag in std::copy, std::equal, ... for standard containers
+
+template<typename Src, typename Dst>
+void copy(const Src& src, Dst& dst, kind_tag<0>) { generic::copy(src, dst); }
+
+template<typename Src, typename Dst>
+void copy(const Src& src, Dst& dst, kind_tag<1>) {
+    typedef iterator_trait<const Src> S;
+    std::memcpy(iterator_trait<Dst>::data(dst), S::data(src),
+                S::size(src) * sizeof(typename S::value_type));
+}
+
+// dst must hold at least as many elements as src
+template<typename Src, typename Dst>
+void copy(const Src& src, Dst& dst) {
+    const bool same = std::is_same<
+        typename iterator_trait<const Src>::value_type,
+        typename iterator_trait<Dst>::value_type>::value;
+    bulk::copy(src, dst, kind_tag<same && algorithm_kind<const Src>::bulk &&
+                            algorithm_kind<Dst>::bulk>());
+}
+
+template<typename C, typename V>
+void fill(C& c, const V& v, kind_tag<0>) { generic::fill(c, v); }
+
+// memset only works when every byte of the value is the same, e.g. 0 or -1
+template<typename T>
+bool uniform_bytes(const T& x, unsigned char& byte) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &x, sizeof(T));
+    byte = bytes[0];
+    return std::memcmp(bytes, bytes + 1, sizeof(T) - 1) == 0;
+}
+
+template<typename C, typename V>
+void fill(C& c, const V& v, kind_tag<1>) {
+    typedef iterator_trait<C> Trait;
+    typename Trait::value_type x(v);
+    unsigned char byte;
+    if (uniform_bytes(x, byte))
+        std::memset(Trait::data(c), byte, Trait::size(c) * sizeof(x));
+    else
+        generic::fill(c, x);
+}
+
+template<typename C, typename V>
+void fill(C& c, const V& v, kind_tag<2>) {
+    typedef iterator_trait<C> Trait;
+    typename Trait::value_type x(v);
+    unsigned char byte;
+    if (uniform_bytes(x, byte))
+        std::memset(Trait::data(c), byte, Trait::size(c) * sizeof(x));
+    else
+        kernel::fill(Trait::data(c), Trait::size(c), x);
+}
+
+template<typename C, typename V>
+void fill(C& c, const V& v) {
+    typedef algorithm_kind<C> K;
+    bulk::fill(c, v, kind_tag<K::simd ? 2 : K::bulk ? 1 : 0>());
+}
+
+template<typename A, typename B>
+bool equal(const A& a, const B& b, kind_tag<0>) { return generic::equal(a, b); }
+
+template<typename A, typename B>
+bool equal(const A& a, const B& b, kind_tag<1>) {
+    typedef iterator_trait<const A> TA;
+    typedef iterator_trait<const B> TB;
+    return TA::size(a) == TB::size(b) &&
+        std::memcmp(TA::data(a), TB::data(b),
+                    TA::size(a) * sizeof(typename TA::value_type)) == 0;
+}
+
+template<typename A, typename B>
+bool equal(const A& a, const B& b, kind_tag<2>) {
+    typedef iterator_trait<const A> TA;
+    typedef iterator_trait<const B> TB;
+    return TA::size(a) == TB::size(b) &&
+        kernel::equal(TA::data(a), TB::data(b), TA::size(a));
+}
+
+template<typename A, typename B>
+bool equal(const A& a, const B& b) {
+    typedef algorithm_kind<const A> KA;
+    typedef algorithm_kind<const B> KB;
+    const bool same = std::is_same<typename KA::value_type,
+                                   typename KB::value_type>::value;
+    return bulk::equal(a, b, kind_tag<
+        !same ? 0 : KA::bytewise && KB::bytewise ? 1 :
+        KA::simd && KB::simd ? 2 : 0>());
+}
+
+template<typename C, typename V>
+typename iterator_trait<const C>::iterator
+find(const C& c, const V& v, kind_tag<0>) { return generic::find(c, v); }
+
+template<typename C, typename V>
+typename iterator_trait<const C>::iterator
+find(const C& c, const V& v, kind_tag<2>) {
+    typedef iterator_trait<const C> Trait;
+    // a needle the elements cannot hold, 2.5 among ints, matches none
+    typename Trait::value_type x(v);
+    if (!(x == v))
+        return Trait::end(c);
+    return Trait::begin(c) + kernel::find(Trait::data(c), Trait::size(c), x);
+}
+
+template<typename C, typename V>
+typename iterator_trait<const C>::iterator
+find(const C& c, const V& v, kind_tag<1>) {
+    typedef iterator_trait<const C> Trait;
+    typename Trait::value_type x(v);
+    if (!(x == v))
+        return Trait::end(c);
+    const void* p = std::memchr(Trait::data(c),
+        static_cast<unsigned char>(x), Trait::size(c));
+    return Trait::begin(c) + (p ? static_cast<const unsigned char*>(p) -
+        reinterpret_cast<const unsigned char*>(Trait::data(c)) : Trait::size(c));
+}
+
+template<typename C, typename V>
+typename iterator_trait<const C>::iterator find(const C& c, const V& v) {
+    typedef algorithm_kind<const C> K;
+    // memchr for one-byte integers such as the chars of a string
+    const bool bytes = K::bytewise && sizeof(typename K::value_type) == 1;
+    return bulk::find(c, v, kind_tag<K::simd ? 2 : bytes ? 1 : 0>());
+}
+
+template<typename C>
+typename iterator_trait<const C>::value_type sum(const C& c, kind_tag<0>)
+    { return generic::sum(c); }
+
+// float and double sums are reassociated across lanes, so they can
+// differ from a left-to-right sum in the last bits
+template<typename C>
+typename iterator_trait<const C>::value_type sum(const C& c, kind_tag<2>) {
+    typedef iterator_trait<const C> Trait;
+    return kernel::sum(Trait::data(c), Trait::size(c));
+}
+
+template<typename C>
+typename iterator_trait<const C>::value_type sum(const C& c) {
+    return bulk::sum(c, kind_tag<algorithm_kind<const C>::simd ? 2 : 0>());
+}
+
+template<typename C>
+std::pair<typename iterator_trait<const C>::value_type,
+          typename iterator_trait<const C>::value_type>
+minmax(const C& c, kind_tag<0>) { return generic::minmax(c); }
+
+template<typename C>
+std::pair<typename iterator_trait<const C>::value_type,
+          typename iterator_trait<const C>::value_type>
+minmax(const C& c, kind_tag<2>) {
+    typedef iterator_trait<const C> Trait;
+    return kernel::minmax(Trait::data(c), Trait::size(c));
+}
+
+// requires a non-empty container; NaNs give unspecified results
+template<typename C>
+std::pair<typename iterator_trait<const C>::value_type,
+          typename iterator_trait<const C>::value_type>
+minmax(const C& c) {
+    return bulk::minmax(c, kind_tag<algorithm_kind<const C>::simd ? 2 : 0>());
+}
+
+template<typename C>
+typename iterator_trait<const C>::value_type min(const C& c)
+    { return minmax(c).first; }
+
+template<typename C>
+typename iterator_trait<const C>::value_type max(const C& c)
+    { return minmax(c).second; }
+
+} // namespace bulk
+
+#endif
@@ -8,7 +8,11 @@
 #include <iostream>
 #include <string>
 #include <regex>
+#ifdef BENCH
+#include "bench.h"
+#endif
 
+#ifndef BENCH
 int main ()
 {
   const char cstr[] = "subject";
@@ -75,3 +79,24 @@ int main ()
 
   return 0;
 }
+#else
+int main (int argc, char* argv[])
+{
+  bench::suite suite("regex", argc, argv);
+
+  std::string s ("subject");
+  std::regex e ("(sub)(.*)");
+  suite.run("regex_match", [&] {
+    bench::do_not_optimize(std::regex_match (s,e));
+  });
+
+  std::string ss = "http://www.foo.com/bar";
+  std::regex re(R"((ftp|http|https):\/\/((\w+\.)*(\w*))\/([\w\d]+\/{0,1})+)");
+  std::cmatch matches;
+  suite.run("regex_match_url", [&] {
+    bench::do_not_optimize(regex_match(ss.c_str(), matches, re));
+  });
+
+  return suite.finish();
+}
+#endif
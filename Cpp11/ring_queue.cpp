@@ -0,0 +1,251 @@
+//
+//  ring_queue.cpp
+//
+//  Created on 10/19/26.
+//
+//  ring_queue.h in use: handing move-only buffers (Intvec from rvalue.cpp
+//  without its copy constructor) and std::strings from producer threads
+//  to consumer threads. Throughput is measured for one to four pairs of
+//  threads, one element at a time and in batches, against a std::deque
+//  behind a mutex; latency is the one-way time of a ping-pong between two
+//  threads.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include "ring_queue.h"
+
+using namespace std;
+
+// Intvec's payload, movable and nothing else
+class buffer {
+public:
+    explicit buffer(size_t num = 0) : m_size(num), m_data(num ? new int[num] : nullptr) {
+        for (size_t i = 0; i < num; ++i)
+            m_data[i] = int(i);
+    }
+    buffer(buffer&&) = default;
+    buffer& operator=(buffer&&) = default;
+
+    size_t size() const { return m_size; }
+
+private:
+    size_t m_size;
+    unique_ptr<int[]> m_data;
+};
+
+// what we would write without ring_queue.h
+template<typename T>
+class locked_queue {
+public:
+    explicit locked_queue(size_t capacity) : m_capacity(capacity) { }
+
+    bool try_push(T&& x) {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_items.size() == m_capacity)
+            return false;
+        m_items.push_back(std::move(x));
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_items.empty())
+            return false;
+        out = std::move(m_items.front());
+        m_items.pop_front();
+        return true;
+    }
+
+    template<typename It>
+    size_t push_batch(It first, size_t n) {
+        lock_guard<mutex> lock(m_mutex);
+        n = min(n, m_capacity - m_items.size());
+        for (size_t i = 0; i < n; ++i, ++first)
+            m_items.push_back(std::move(*first));
+        return n;
+    }
+
+    template<typename OutIt>
+    size_t pop_batch(OutIt out, size_t n) {
+        lock_guard<mutex> lock(m_mutex);
+        n = min(n, m_items.size());
+        for (size_t i = 0; i < n; ++i, ++out) {
+            *out = std::move(m_items.front());
+            m_items.pop_front();
+        }
+        return n;
+    }
+
+private:
+    size_t m_capacity;
+    mutex m_mutex;
+    deque<T> m_items;
+};
+
+template<typename T> T make_payload(size_t i);
+template<> int make_payload<int>(size_t i) { return int(i); }
+template<> string make_payload<string>(size_t i) {
+    return "payload number " + to_string(i) + " past the short string buffer";
+}
+template<> buffer make_payload<buffer>(size_t i) { return buffer(16 + i % 16); }
+
+size_t weight(int x) { return size_t(x); }
+size_t weight(const string& s) { return s.size(); }
+size_t weight(const buffer& b) { return b.size(); }
+
+// Elements per microsecond through the queue; every producer makes
+// items / producers payloads and pushes them `batch` at a time.
+template<typename Queue, typename T>
+double throughput(int producers, int consumers, size_t items, size_t batch,
+                  bool& ok) {
+    Queue q(1024);
+    const size_t per = items / producers;
+    const size_t total = per * producers;
+    atomic<size_t> popped(0), weight_in(0), weight_out(0);
+    vector<thread> threads;
+    auto start = chrono::steady_clock::now();
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&, p] {
+            vector<T> ready;
+            size_t w = 0;
+            for (size_t i = 0; i < per; ) {
+                ready.clear();
+                size_t n = min(batch, per - i);
+                for (size_t j = 0; j < n; ++j) {
+                    ready.push_back(make_payload<T>(p * per + i + j));
+                    w += weight(ready.back());
+                }
+                ring_queue_detail::backoff b;
+                for (size_t done = 0; done < n; ) {
+                    size_t k = batch == 1 ? q.try_push(std::move(ready[done]))
+                                          : q.push_batch(ready.begin() + done, n - done);
+                    if (k == 0)
+                        b.pause();
+                    done += k;
+                }
+                i += n;
+            }
+            weight_in += w;
+        });
+    for (int c = 0; c < consumers; ++c)
+        threads.emplace_back([&] {
+            vector<T> out(batch);
+            size_t w = 0;
+            ring_queue_detail::backoff b;
+            while (popped.load(memory_order_relaxed) < total) {
+                size_t k = batch == 1 ? q.try_pop(out[0]) : q.pop_batch(out.begin(), batch);
+                if (k == 0) {
+                    b.pause();
+                    continue;
+                }
+                for (size_t j = 0; j < k; ++j)
+                    w += weight(out[j]);
+                popped += k;
+            }
+            weight_out += w;
+        });
+    for (thread& t : threads)
+        t.join();
+    chrono::duration<double, micro> us = chrono::steady_clock::now() - start;
+    ok = ok && popped == total && weight_in == weight_out;
+    return total / us.count();
+}
+
+// One-way ns: a token goes there and back `rounds` times
+template<typename Queue>
+double ping_pong(size_t rounds) {
+    Queue there(64), back(64);
+    thread echo([&] {
+        for (size_t i = 0; i < rounds; ++i) {
+            int x;
+            ring_queue_detail::backoff b;
+            while (!there.try_pop(x))
+                b.pause();
+            while (!back.try_push(std::move(x)))
+                b.pause();
+        }
+    });
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; ++i) {
+        int x = int(i);
+        ring_queue_detail::backoff b;
+        while (!there.try_push(std::move(x)))
+            b.pause();
+        while (!back.try_pop(x))
+            b.pause();
+    }
+    chrono::duration<double, nano> ns = chrono::steady_clock::now() - start;
+    echo.join();
+    return ns.count() / (2.0 * rounds);
+}
+
+template<typename T>
+void table(const char* name, size_t items, bool& ok) {
+    const int pairs[] = { 1, 2, 4 };
+    for (size_t batch : { size_t(1), size_t(32) }) {
+        for (int n : pairs) {
+            cout << setw(8) << name << setw(7) << batch << setw(5) << n << "x" << n
+                 << fixed << setprecision(2);
+            if (n == 1)
+                cout << setw(10) << throughput<spsc_queue<T>, T>(1, 1, items, batch, ok);
+            else
+                cout << setw(10) << "-";
+            cout << setw(10) << throughput<mpmc_queue<T>, T>(n, n, items, batch, ok)
+                 << setw(10) << throughput<locked_queue<T>, T>(n, n, items, batch, ok)
+                 << endl;
+        }
+    }
+}
+
+int main()
+{
+    spsc_queue<buffer> q(4);
+    q.push(buffer(20));
+    q.push(buffer(30));
+    buffer b;
+    q.pop(b);
+    cout << "spsc capacity " << q.capacity() << ", popped a buffer of "
+         << b.size() << ", " << q.size() << " left" << endl; // 4, 20, 1
+
+    mpmc_queue<string> m(3);
+    vector<string> words{ "one", "two", "three", "four", "five" };
+    size_t pushed = m.push_batch(words.begin(), words.size());
+    vector<string> out(8);
+    size_t got = m.pop_batch(out.begin(), out.size());
+    cout << "mpmc capacity " << m.capacity() << ", pushed " << pushed
+         << ", popped " << got << ": " << out[0] << " .. " << out[got - 1]
+         << endl; // 4, 4, 4: one .. four
+
+    mpmc_queue<int> one(1);
+    int pushed_one = one.try_push(1) + one.try_push(2) + one.try_push(3);
+    cout << "mpmc asked for 1: capacity " << one.capacity() << ", pushed "
+         << pushed_one << " of 3" << endl; // 2, 2
+
+    /////////////////////////////////////////////////////////
+    bool ok = true;
+    cout << "elements per microsecond, " << thread::hardware_concurrency()
+         << " hardware threads" << endl;
+    cout << setw(8) << "payload" << setw(7) << "batch" << setw(7) << "pairs"
+         << setw(10) << "spsc" << setw(10) << "mpmc" << setw(10) << "locked"
+         << endl;
+    table<int>("int", 1000000, ok);
+    table<string>("string", 400000, ok);
+    table<buffer>("buffer", 400000, ok);
+
+    const size_t rounds = 20000;
+    cout << "ping-pong, one-way ns: spsc " << setprecision(0)
+         << ping_pong<spsc_queue<int>>(rounds) << ", mpmc "
+         << ping_pong<mpmc_queue<int>>(rounds) << ", locked "
+         << ping_pong<locked_queue<int>>(rounds) << endl;
+    if (!ok)
+        cout << "MISMATCH" << endl;
+}
@@ -0,0 +1,358 @@
+//
+//  ring_queue.h
+//
+//  Created on 10/19/26.
+//  https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+//  https://rigtorp.se/ringbuffer/
+//
+//  Bounded lock-free queues over a ring of slots that hold the elements
+//  themselves, so pushing an Intvec or a std::string moves it into the
+//  ring and popping moves it out again; nothing is copied and nothing is
+//  allocated after construction. The capacity is rounded up to a power of
+//  two, and for mpmc_queue to at least 2.
+//
+//  spsc_queue is for one producer thread and one consumer thread: each
+//  side owns one index and keeps a cached copy of the other's, so it only
+//  touches the other side's cache line when the cached copy says the ring
+//  is full or empty. mpmc_queue takes any number of both: every slot has
+//  a sequence number telling whose turn it is, and producers and consumers
+//  claim positions with a compare-and-swap. Indices written by different
+//  threads sit on different cache lines.
+//
+//  The try_ operations never wait. push_batch and pop_batch move up to n
+//  elements but publish them (spsc) or claim them (mpmc) once.
+
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace ring_queue_detail {
+
+inline size_t ring_size(size_t capacity, size_t least = 1) {
+    if (capacity == 0)
+        throw std::invalid_argument("ring queue: capacity must be positive");
+    size_t n = least;
+    while (n < capacity)
+        n *= 2;
+    return n;
+}
+
+// Spins a little, then gives the processor away; with more threads than
+// cores the thread we wait for may need it.
+class backoff {
+public:
+    backoff() : m_spins(0) { }
+    void pause() {
+        if (++m_spins > 16)
+            std::this_thread::yield();
+    }
+
+private:
+    int m_spins;
+};
+
+template<typename T>
+struct slot_storage {
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type bytes;
+    T* get() { return reinterpret_cast<T*>(&bytes); }
+};
+
+} // namespace ring_queue_detail
+
+////////////////////////////////////////////////////////////
+template<typename T>
+class spsc_queue {
+public:
+    explicit spsc_queue(size_t capacity)
+        : m_head(0), m_tail_cache(0), m_tail(0), m_head_cache(0),
+          m_mask(ring_queue_detail::ring_size(capacity) - 1),
+          m_slots(new slot[m_mask + 1]) { }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue() {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        for (size_t i = m_head.load(std::memory_order_relaxed); i != tail; ++i)
+            m_slots[i & m_mask].get()->~T();
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+
+    // a snapshot; exact only while both sides are idle
+    size_t size() const {
+        return m_tail.load(std::memory_order_acquire) -
+               m_head.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+
+    /////////////////////////////////////////////////////////
+    // producer side
+    template<typename... Args>
+    bool try_emplace(Args&&... args) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head_cache == capacity()) {
+            m_head_cache = m_head.load(std::memory_order_acquire);
+            if (tail - m_head_cache == capacity())
+                return false;
+        }
+        ::new (m_slots[tail & m_mask].get()) T(std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& x) { return try_emplace(x); }
+    bool try_push(T&& x) { return try_emplace(std::move(x)); }
+
+    void push(T&& x) {
+        ring_queue_detail::backoff b;
+        while (!try_emplace(std::move(x)))
+            b.pause();
+    }
+
+    // moves up to n elements from first on and publishes them together;
+    // returns how many fitted
+    template<typename It>
+    size_t push_batch(It first, size_t n) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (capacity() - (tail - m_head_cache) < n)
+            m_head_cache = m_head.load(std::memory_order_acquire);
+        n = std::min(n, capacity() - (tail - m_head_cache));
+        for (size_t i = 0; i < n; ++i, ++first)
+            ::new (m_slots[(tail + i) & m_mask].get()) T(std::move(*first));
+        if (n)
+            m_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    /////////////////////////////////////////////////////////
+    // consumer side
+    bool try_pop(T& out) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail_cache) {
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+            if (head == m_tail_cache)
+                return false;
+        }
+        T* x = m_slots[head & m_mask].get();
+        out = std::move(*x);
+        x->~T();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void pop(T& out) {
+        ring_queue_detail::backoff b;
+        while (!try_pop(out))
+            b.pause();
+    }
+
+    // moves up to n elements to out and frees their slots together
+    template<typename OutIt>
+    size_t pop_batch(OutIt out, size_t n) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (m_tail_cache - head < n)
+            m_tail_cache = m_tail.load(std::memory_order_acquire);
+        n = std::min(n, m_tail_cache - head);
+        for (size_t i = 0; i < n; ++i) {
+            T* x = m_slots[(head + i) & m_mask].get();
+            *out = std::move(*x);
+            ++out;
+            x->~T();
+        }
+        if (n)
+            m_head.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+private:
+    typedef ring_queue_detail::slot_storage<T> slot;
+
+    // consumer's line
+    alignas(64) std::atomic<size_t> m_head;
+    size_t m_tail_cache;
+    // producer's line
+    alignas(64) std::atomic<size_t> m_tail;
+    size_t m_head_cache;
+    // read by both, written by neither
+    alignas(64) const size_t m_mask;
+    std::unique_ptr<slot[]> m_slots;
+};
+
+////////////////////////////////////////////////////////////
+// After Dmitry Vyukov's bounded MPMC queue. Slot i of lap k has sequence
+// number i + k * capacity while free for a producer, one more once full,
+// and i + (k + 1) * capacity when freed again by its consumer. With one
+// slot, freed and full would both be i + 1, so there are at least two.
+template<typename T>
+class mpmc_queue {
+public:
+    explicit mpmc_queue(size_t capacity)
+        : m_tail(0), m_head(0),
+          m_mask(ring_queue_detail::ring_size(capacity, 2) - 1),
+          m_slots(new slot[m_mask + 1]) {
+        for (size_t i = 0; i <= m_mask; ++i)
+            m_slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue() {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        for (size_t i = m_head.load(std::memory_order_relaxed); i != tail; ++i)
+            m_slots[i & m_mask].value.get()->~T();
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+
+    size_t size() const {
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        size_t head = m_head.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+    bool empty() const { return size() == 0; }
+
+    /////////////////////////////////////////////////////////
+    template<typename... Args>
+    bool try_emplace(Args&&... args) {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+            slot& s = m_slots[pos & m_mask];
+            intptr_t diff = intptr_t(s.seq.load(std::memory_order_acquire)) - intptr_t(pos);
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    ::new (s.value.get()) T(std::forward<Args>(args)...);
+                    s.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // a lap behind: full
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_push(const T& x) { return try_emplace(x); }
+    bool try_push(T&& x) { return try_emplace(std::move(x)); }
+
+    void push(T&& x) {
+        ring_queue_detail::backoff b;
+        while (!try_emplace(std::move(x)))
+            b.pause();
+    }
+
+    // claims up to n free slots in a row with one compare-and-swap
+    template<typename It>
+    size_t push_batch(It first, size_t n) {
+        if (n == 0)
+            return 0;
+        size_t pos = m_tail.load(std::memory_order_relaxed), k;
+        for (;;) {
+            for (k = 0; k < n; ++k) {
+                size_t seq = m_slots[(pos + k) & m_mask].seq.load(std::memory_order_acquire);
+                if (seq != pos + k)
+                    break;
+            }
+            if (k == 0) {
+                size_t seq = m_slots[pos & m_mask].seq.load(std::memory_order_acquire);
+                if (intptr_t(seq) - intptr_t(pos) < 0)
+                    return 0;
+                pos = m_tail.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (m_tail.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+                break;
+        }
+        for (size_t i = 0; i < k; ++i, ++first) {
+            slot& s = m_slots[(pos + i) & m_mask];
+            ::new (s.value.get()) T(std::move(*first));
+            s.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        return k;
+    }
+
+    /////////////////////////////////////////////////////////
+    bool try_pop(T& out) {
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        for (;;) {
+            slot& s = m_slots[pos & m_mask];
+            intptr_t diff = intptr_t(s.seq.load(std::memory_order_acquire)) -
+                            intptr_t(pos + 1);
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(*s.value.get());
+                    s.value.get()->~T();
+                    s.seq.store(pos + m_mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // not filled yet: empty
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void pop(T& out) {
+        ring_queue_detail::backoff b;
+        while (!try_pop(out))
+            b.pause();
+    }
+
+    // claims up to n filled slots in a row with one compare-and-swap
+    template<typename OutIt>
+    size_t pop_batch(OutIt out, size_t n) {
+        if (n == 0)
+            return 0;
+        size_t pos = m_head.load(std::memory_order_relaxed), k;
+        for (;;) {
+            for (k = 0; k < n; ++k) {
+                size_t seq = m_slots[(pos + k) & m_mask].seq.load(std::memory_order_acquire);
+                if (seq != pos + k + 1)
+                    break;
+            }
+            if (k == 0) {
+                size_t seq = m_slots[pos & m_mask].seq.load(std::memory_order_acquire);
+                if (intptr_t(seq) - intptr_t(pos + 1) < 0)
+                    return 0;
+                pos = m_head.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (m_head.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+                break;
+        }
+        for (size_t i = 0; i < k; ++i) {
+            slot& s = m_slots[(pos + i) & m_mask];
+            *out = std::move(*s.value.get());
+            ++out;
+            s.value.get()->~T();
+            s.seq.store(pos + i + m_mask + 1, std::memory_order_release);
+        }
+        return k;
+    }
+
+private:
+    struct slot {
+        std::atomic<size_t> seq;
+        ring_queue_detail::slot_storage<T> value;
+    };
+
+    alignas(64) std::atomic<size_t> m_tail;
+    alignas(64) std::atomic<size_t> m_head;
+    alignas(64) const size_t m_mask;
+    std::unique_ptr<slot[]> m_slots;
+};
+
+#endif
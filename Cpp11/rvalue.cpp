@@ -8,6 +8,10 @@
 #include <iostream>
 #include <vector>
 
+#ifdef BENCH
+#include "bench.h"
+#endif
+
 int g_constructCount=0;
 int g_copyConstructCount=0;
 int g_destructCount=0;
@@ -78,7 +82,9 @@ public:
 private:
     void log(const char* msg)
     {
+#ifndef BENCH
         std::cout << "[" << this << "] " << msg << "\n";
+#endif
     }
 
     size_t m_size;
@@ -96,6 +102,7 @@ template <class T> void fn (T&& x) {
   overloaded (std::forward<T>(x));  // rvalue if argument is rvalue
 }
 
+#ifndef BENCH
 int main()
 {
   int i;
@@ -145,3 +152,30 @@ int main()
                                        << "\", \"" << v[1] << "\"\n";
   return 0;
 }
+#else
+int main(int argc, char* argv[])
+{
+  bench::suite suite("rvalue", argc, argv);
+
+  Intvec v1(1000);
+  Intvec v2(1000);
+
+  suite.run("intvec_copy_assign", [&] {
+    v2 = v1;
+    bench::do_not_optimize(v2);
+  });
+
+  // swaps the buffers of v1 and v2 back and forth
+  suite.run("intvec_move_assign", [&] {
+    v2 = std::move(v1);
+    bench::do_not_optimize(v2);
+  });
+
+  suite.run("intvec_move_assign_temporary", [&] {
+    v2 = Intvec(1000);
+    bench::do_not_optimize(v2);
+  });
+
+  return suite.finish();
+}
+#endif
@@ -0,0 +1,298 @@
+//
+//  static_vector.h
+//
+//  Created on 10/19/26.
+//  http://en.cppreference.com/w/cpp/container/vector
+//  https://www.boost.org/doc/libs/release/doc/html/container/non_standard_containers.html#container.non_standard_containers.static_vector
+//
+//  A vector with its capacity N fixed at compile time and its elements
+//  stored inline, so building one never touches the heap. N can come from
+//  any constant expression, e.g. length(nums) * 2 in constexpr.cpp. When T
+//  is trivially copyable so is static_vector<T, N>, and then it is also a
+//  literal type: it can be built from an array, sized and indexed in
+//  constant expressions.
+
+#ifndef STATIC_VECTOR_H
+#define STATIC_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "indices.h"
+
+namespace static_vector_detail {
+
+// Trivially copyable elements: the implicit copy and destructor are
+// trivial too, and the array constructor is constexpr.
+template<typename T, size_t N,
+         bool Trivial = std::is_trivially_copyable<T>::value>
+class storage {
+protected:
+    constexpr storage() : m_none(), m_size(0) { }
+
+    template<size_t M, size_t... Is>
+    constexpr storage(const T (&a)[M], indices<Is...>)
+        : m_elems{ a[Is]... }, m_size(M) { }
+
+    union {
+        char m_none;
+        T m_elems[N];
+    };
+    size_t m_size;
+};
+
+// Everything else constructs and destroys elements one by one.
+template<typename T, size_t N>
+class storage<T, N, false> {
+protected:
+    storage() : m_none(), m_size(0) { }
+
+    template<size_t M, size_t... Is>
+    storage(const T (&a)[M], indices<Is...>) : m_none(), m_size(0) {
+        append(a, a + M);
+    }
+
+    storage(const storage& other) : m_none(), m_size(0) {
+        append(other.m_elems, other.m_elems + other.m_size);
+    }
+
+    storage(storage&& other)
+        noexcept(std::is_nothrow_move_constructible<T>::value)
+        : m_none(), m_size(0) {
+        append(std::make_move_iterator(other.m_elems),
+               std::make_move_iterator(other.m_elems + other.m_size));
+        other.truncate(0);
+    }
+
+    storage& operator=(const storage& other) {
+        if (this != &other)
+            assign(other.m_elems, other.m_elems + other.m_size);
+        return *this;
+    }
+
+    storage& operator=(storage&& other)
+        noexcept(std::is_nothrow_move_constructible<T>::value &&
+                 std::is_nothrow_move_assignable<T>::value) {
+        if (this != &other) {
+            assign(std::make_move_iterator(other.m_elems),
+                   std::make_move_iterator(other.m_elems + other.m_size));
+            other.truncate(0);
+        }
+        return *this;
+    }
+
+    ~storage() { truncate(0); }
+
+    union {
+        char m_none;
+        T m_elems[N];
+    };
+    size_t m_size;
+
+private:
+    template<typename It>
+    void append(It first, It last) {
+        for (; first != last; ++first) {
+            ::new (m_elems + m_size) T(*first);
+            ++m_size;
+        }
+    }
+
+    // both sides hold at most N elements
+    template<typename It>
+    void assign(It first, It last) {
+        size_t i = 0;
+        for (; i < m_size && first != last; ++i, ++first)
+            m_elems[i] = *first;
+        truncate(i);
+        append(first, last);
+    }
+
+    void truncate(size_t n) {
+        while (m_size > n)
+            m_elems[--m_size].~T();
+    }
+};
+
+} // namespace static_vector_detail
+
+////////////////////////////////////////////////////////////
+template<typename T, size_t N>
+class static_vector : public static_vector_detail::storage<T, N> {
+    static_assert(N > 0, "static_vector needs a capacity of at least one");
+    typedef static_vector_detail::storage<T, N> base;
+
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    constexpr static_vector() { }
+
+    // constexpr for trivially copyable T:
+    //   constexpr static_vector<int, length(nums) * 2> v(nums);
+    template<size_t M>
+    constexpr static_vector(const T (&a)[M])
+        : base(a, make_indices<M>()) {
+        static_assert(M <= N, "static_vector: array longer than the capacity");
+    }
+
+    explicit static_vector(size_type n) { resize(n); }
+
+    static_vector(size_type n, const T& value) { resize(n, value); }
+
+    template<typename InputIt, typename = typename std::enable_if<
+        !std::is_integral<InputIt>::value>::type>
+    static_vector(InputIt first, InputIt last) {
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    static_vector(std::initializer_list<T> l)
+        : static_vector(l.begin(), l.end()) { }
+
+    /////////////////////////////////////////////////////////
+    iterator begin() { return this->m_elems; }
+    iterator end() { return this->m_elems + this->m_size; }
+    constexpr const_iterator begin() const { return this->m_elems; }
+    constexpr const_iterator end() const { return this->m_elems + this->m_size; }
+    constexpr const_iterator cbegin() const { return begin(); }
+    constexpr const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    constexpr size_type size() const { return this->m_size; }
+    constexpr bool empty() const { return this->m_size == 0; }
+    static constexpr size_type capacity() { return N; }
+    static constexpr size_type max_size() { return N; }
+
+    pointer data() { return this->m_elems; }
+    constexpr const_pointer data() const { return this->m_elems; }
+
+    reference operator[](size_type i) { return this->m_elems[i]; }
+    constexpr const_reference operator[](size_type i) const
+        { return this->m_elems[i]; }
+
+    reference at(size_type i) {
+        if (i >= this->m_size)
+            throw std::out_of_range("static_vector::at");
+        return this->m_elems[i];
+    }
+    // C++11 constexpr functions throw from the conditional operator
+    constexpr const_reference at(size_type i) const {
+        return i < this->m_size ? this->m_elems[i] :
+            throw std::out_of_range("static_vector::at");
+    }
+
+    reference front() { return this->m_elems[0]; }
+    constexpr const_reference front() const { return this->m_elems[0]; }
+    reference back() { return this->m_elems[this->m_size - 1]; }
+    constexpr const_reference back() const { return this->m_elems[this->m_size - 1]; }
+
+    /////////////////////////////////////////////////////////
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template<typename... Args>
+    reference emplace_back(Args&&... args) {
+        check_room();
+        ::new (end()) T(std::forward<Args>(args)...);
+        ++this->m_size;
+        return back();
+    }
+
+    void pop_back() {
+        back().~T();
+        --this->m_size;
+    }
+
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        iterator p = begin() + (pos - cbegin());
+        if (p == end()) {
+            emplace_back(std::forward<Args>(args)...);
+            return p;
+        }
+        check_room();
+        T value(std::forward<Args>(args)...); // args may refer to an element
+        ::new (end()) T(std::move(back()));
+        ++this->m_size;
+        std::move_backward(p, end() - 2, end() - 1);
+        *p = std::move(value);
+        return p;
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        iterator f = begin() + (first - cbegin());
+        iterator l = begin() + (last - cbegin());
+        if (f != l)
+            truncate(std::move(l, end(), f) - begin());
+        return f;
+    }
+
+    void clear() { truncate(0); }
+
+    void resize(size_type n) {
+        if (n > N)
+            throw std::length_error("static_vector: capacity exceeded");
+        truncate(n);
+        while (this->m_size < n)
+            emplace_back();
+    }
+
+    void resize(size_type n, const T& value) {
+        if (n > N)
+            throw std::length_error("static_vector: capacity exceeded");
+        truncate(n);
+        while (this->m_size < n)
+            emplace_back(value);
+    }
+
+private:
+    void check_room() const {
+        if (this->m_size == N)
+            throw std::length_error("static_vector: capacity exceeded");
+    }
+
+    void truncate(size_type n) {
+        while (this->m_size > n)
+            this->m_elems[--this->m_size].~T();
+    }
+};
+
+template<typename T, size_t N, size_t M>
+bool operator==(const static_vector<T, N>& l, const static_vector<T, M>& r) {
+    return l.size() == r.size() && std::equal(l.begin(), l.end(), r.begin());
+}
+
+template<typename T, size_t N, size_t M>
+bool operator!=(const static_vector<T, N>& l, const static_vector<T, M>& r) {
+    return !(l == r);
+}
+
+template<typename T, size_t N, size_t M>
+bool operator<(const static_vector<T, N>& l, const static_vector<T, M>& r) {
+    return std::lexicographical_compare(l.begin(), l.end(), r.begin(), r.end());
+}
+
+#endif
@@ -0,0 +1,394 @@
+//
+//  strided_view.h
+//
+//  Created on 10/19/26.
+//  http://en.cppreference.com/w/cpp/numeric/valarray/slice_array
+//  http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2019/p0009r9.html
+//
+//  Views into the elements of a vec or a mat from CRTP.h, without copying
+//  them. strided_view<T, N> is N elements a fixed distance apart: a row of
+//  a mat (distance 1), a column (distance one row), or every k-th element
+//  of a vec. matrix_view<T, R, C> is R rows of C elements with a distance
+//  between rows and one between columns, so a transpose swaps the two
+//  distances and a block only moves the start.
+//
+//  Views take the same add_ops and fmt_ops policies as vec and mat:
+//  view + x builds a new vec or mat, and << prints like one. Assigning
+//  to a view and += on a view write through to the elements viewed, in
+//  place. Where both sides have unit stride the loops run over plain
+//  arrays; otherwise they gather with the strides. The elements written
+//  must not overlap the ones read, unless they are the same elements.
+
+#ifndef STRIDED_VIEW_H
+#define STRIDED_VIEW_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include "CRTP.h"
+
+template<typename T, size_t N> class strided_view;
+template<typename T, size_t R, size_t C> class matrix_view;
+
+namespace strided_view_detail {
+
+template<typename T, typename U>
+void assign(T* d, ptrdiff_t ds, const U* s, ptrdiff_t ss, size_t n) {
+    if (ds == 1 && ss == 1) {
+        std::copy(s, s + n, d);
+    } else {
+        for (ptrdiff_t i = 0; i < ptrdiff_t(n); ++i)
+            d[i * ds] = s[i * ss];
+    }
+}
+
+template<typename T, typename U>
+void add(T* d, ptrdiff_t ds, const U* s, ptrdiff_t ss, size_t n) {
+    if (ds == 1 && ss == 1) {
+        // four loads before four stores, which -O2 turns into two SSE2
+        // adds even though d and s may be the same array
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            T a0 = d[i] + s[i], a1 = d[i + 1] + s[i + 1];
+            T a2 = d[i + 2] + s[i + 2], a3 = d[i + 3] + s[i + 3];
+            d[i] = a0;
+            d[i + 1] = a1;
+            d[i + 2] = a2;
+            d[i + 3] = a3;
+        }
+        for (; i < n; ++i)
+            d[i] += s[i];
+    } else {
+        for (ptrdiff_t i = 0; i < ptrdiff_t(n); ++i)
+            d[i * ds] += s[i * ss];
+    }
+}
+
+// the elements of a mat are one array of T, row after row
+template<typename T, size_t N, size_t M>
+T* elements(mat<T, N, M>& m) {
+    static_assert(sizeof(mat<T, N, M>) == sizeof(T) * N * M,
+                  "mat<T, N, M> must be laid out like T[M][N]");
+    return m[0].data();
+}
+
+template<typename T, size_t N, size_t M>
+const T* elements(const mat<T, N, M>& m) {
+    static_assert(sizeof(mat<T, N, M>) == sizeof(T) * N * M,
+                  "mat<T, N, M> must be laid out like T[M][N]");
+    return m[0].data();
+}
+
+template<typename T>
+class strided_iterator {
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename std::remove_const<T>::type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
+
+    strided_iterator() : m_p(nullptr), m_stride(1) { }
+    strided_iterator(T* p, ptrdiff_t stride) : m_p(p), m_stride(stride) { }
+
+    T& operator*() const { return *m_p; }
+    T* operator->() const { return m_p; }
+    T& operator[](ptrdiff_t n) const { return m_p[n * m_stride]; }
+
+    strided_iterator& operator++() { m_p += m_stride; return *this; }
+    strided_iterator& operator--() { m_p -= m_stride; return *this; }
+    strided_iterator operator++(int) { strided_iterator t(*this); ++*this; return t; }
+    strided_iterator operator--(int) { strided_iterator t(*this); --*this; return t; }
+    strided_iterator& operator+=(ptrdiff_t n) { m_p += n * m_stride; return *this; }
+    strided_iterator& operator-=(ptrdiff_t n) { m_p -= n * m_stride; return *this; }
+    friend strided_iterator operator+(strided_iterator it, ptrdiff_t n) { return it += n; }
+    friend strided_iterator operator+(ptrdiff_t n, strided_iterator it) { return it += n; }
+    friend strided_iterator operator-(strided_iterator it, ptrdiff_t n) { return it -= n; }
+    friend ptrdiff_t operator-(const strided_iterator& a, const strided_iterator& b)
+        { return (a.m_p - b.m_p) / a.m_stride; }
+
+    friend bool operator==(const strided_iterator& a, const strided_iterator& b)
+        { return a.m_p == b.m_p; }
+    friend bool operator!=(const strided_iterator& a, const strided_iterator& b)
+        { return a.m_p != b.m_p; }
+    friend bool operator<(const strided_iterator& a, const strided_iterator& b)
+        { return a - b < 0; }
+
+private:
+    T* m_p;
+    ptrdiff_t m_stride;
+};
+
+// walks the rows of a matrix_view, handing out strided_views
+template<typename T, size_t C>
+class row_iterator {
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef strided_view<T, C> value_type;
+    typedef ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef strided_view<T, C> reference;
+
+    row_iterator(T* p, ptrdiff_t rs, ptrdiff_t cs) : m_p(p), m_rs(rs), m_cs(cs) { }
+
+    strided_view<T, C> operator*() const { return strided_view<T, C>(m_p, m_cs); }
+    strided_view<T, C> operator[](ptrdiff_t n) const { return *(*this + n); }
+
+    row_iterator& operator++() { m_p += m_rs; return *this; }
+    row_iterator& operator--() { m_p -= m_rs; return *this; }
+    row_iterator operator++(int) { row_iterator t(*this); ++*this; return t; }
+    row_iterator operator--(int) { row_iterator t(*this); --*this; return t; }
+    row_iterator& operator+=(ptrdiff_t n) { m_p += n * m_rs; return *this; }
+    row_iterator& operator-=(ptrdiff_t n) { m_p -= n * m_rs; return *this; }
+    friend row_iterator operator+(row_iterator it, ptrdiff_t n) { return it += n; }
+    friend row_iterator operator-(row_iterator it, ptrdiff_t n) { return it -= n; }
+    friend ptrdiff_t operator-(const row_iterator& a, const row_iterator& b)
+        { return (a.m_p - b.m_p) / a.m_rs; }
+
+    friend bool operator==(const row_iterator& a, const row_iterator& b)
+        { return a.m_p == b.m_p; }
+    friend bool operator!=(const row_iterator& a, const row_iterator& b)
+        { return a.m_p != b.m_p; }
+
+private:
+    T* m_p;
+    ptrdiff_t m_rs, m_cs;
+};
+
+} // namespace strided_view_detail
+
+// The sum of a view and anything of its shape is a new vec or mat. (B
+// puts off looking into Base, which is incomplete where add_ops names add.)
+template<typename Base>
+struct view_add_impl {
+    template<typename T1, typename B = Base>
+    static typename B::owner_type add(const B& l, const T1& r) {
+        typename B::owner_type sum = l.copy();
+        view(sum) += r;
+        return sum;
+    }
+};
+
+////////////////////////////////////////////////////////////
+template<typename T, size_t N>
+class strided_view : public add_ops<strided_view<T, N>, view_add_impl>,
+        public fmt_ops<strided_view<T, N>, fmt_impl>
+{
+public:
+    typedef typename std::remove_const<T>::type value_type;
+    typedef vec<value_type, N> owner_type;
+    typedef strided_view_detail::strided_iterator<T> iterator;
+    typedef iterator const_iterator;
+
+    explicit strided_view(T* data, ptrdiff_t stride = 1)
+        : m_data(data), m_stride(stride) { }
+
+    // a view of T converts to a view of const T
+    template<typename U, typename = typename std::enable_if<
+        std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type>
+    strided_view(const strided_view<U, N>& v) : m_data(v.data()), m_stride(v.stride()) { }
+
+    strided_view(const strided_view&) = default;
+
+    static constexpr size_t size() { return N; }
+    T* data() const { return m_data; }
+    ptrdiff_t stride() const { return m_stride; }
+    bool contiguous() const { return m_stride == 1; }
+
+    T& operator[](size_t i) const { return m_data[ptrdiff_t(i) * m_stride]; }
+    iterator begin() const { return iterator(m_data, m_stride); }
+    iterator end() const { return iterator(m_data + ptrdiff_t(N) * m_stride, m_stride); }
+
+    owner_type copy() const {
+        owner_type v;
+        strided_view_detail::assign(v.data(), 1, m_data, m_stride, N);
+        return v;
+    }
+
+    // Assignment writes the elements, as with std::slice_array; it never
+    // re-targets the view.
+    strided_view& operator=(const strided_view& other) {
+        strided_view_detail::assign(m_data, m_stride, other.data(), other.stride(), N);
+        return *this;
+    }
+
+    template<typename X>
+    strided_view& operator=(const X& x) {
+        auto s = view(x);
+        static_assert(decltype(s)::size() == N, "strided_view: sizes differ");
+        strided_view_detail::assign(m_data, m_stride, s.data(), s.stride(), N);
+        return *this;
+    }
+
+    // in place, hiding add_ops' += that would go through a new vec
+    template<typename X>
+    strided_view& operator+=(const X& x) {
+        auto s = view(x);
+        static_assert(decltype(s)::size() == N, "strided_view: sizes differ");
+        strided_view_detail::add(m_data, m_stride, s.data(), s.stride(), N);
+        return *this;
+    }
+
+private:
+    T* m_data;
+    ptrdiff_t m_stride;
+};
+
+////////////////////////////////////////////////////////////
+template<typename T, size_t R, size_t C>
+class matrix_view : public add_ops<matrix_view<T, R, C>, view_add_impl>,
+        public fmt_ops<matrix_view<T, R, C>, fmt_impl>
+{
+public:
+    typedef typename std::remove_const<T>::type value_type;
+    typedef mat<value_type, C, R> owner_type;
+    typedef strided_view_detail::row_iterator<T, C> iterator;
+    typedef iterator const_iterator;
+
+    matrix_view(T* data, ptrdiff_t row_stride, ptrdiff_t col_stride)
+        : m_data(data), m_rs(row_stride), m_cs(col_stride) { }
+
+    template<typename U, typename = typename std::enable_if<
+        std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type>
+    matrix_view(const matrix_view<U, R, C>& v)
+        : m_data(v.data()), m_rs(v.row_stride()), m_cs(v.col_stride()) { }
+
+    matrix_view(const matrix_view&) = default;
+
+    static constexpr size_t rows() { return R; }
+    static constexpr size_t cols() { return C; }
+    T* data() const { return m_data; }
+    ptrdiff_t row_stride() const { return m_rs; }
+    ptrdiff_t col_stride() const { return m_cs; }
+    // rows back to back: the whole view is one array of R * C elements
+    bool contiguous() const { return m_cs == 1 && m_rs == ptrdiff_t(C); }
+
+    T& operator()(size_t i, size_t j) const
+        { return m_data[ptrdiff_t(i) * m_rs + ptrdiff_t(j) * m_cs]; }
+    strided_view<T, C> operator[](size_t i) const { return row(i); }
+    strided_view<T, C> row(size_t i) const
+        { return strided_view<T, C>(m_data + ptrdiff_t(i) * m_rs, m_cs); }
+    strided_view<T, R> col(size_t j) const
+        { return strided_view<T, R>(m_data + ptrdiff_t(j) * m_cs, m_rs); }
+    matrix_view<T, C, R> transpose() const
+        { return matrix_view<T, C, R>(m_data, m_cs, m_rs); }
+
+    template<size_t R2, size_t C2>
+    matrix_view<T, R2, C2> block(size_t i, size_t j) const {
+        static_assert(R2 <= R && C2 <= C, "matrix_view: block larger than the view");
+        return matrix_view<T, R2, C2>(&(*this)(i, j), m_rs, m_cs);
+    }
+
+    iterator begin() const { return iterator(m_data, m_rs, m_cs); }
+    iterator end() const { return iterator(m_data + ptrdiff_t(R) * m_rs, m_rs, m_cs); }
+
+    owner_type copy() const {
+        owner_type m;
+        view(m) = *this;
+        return m;
+    }
+
+    matrix_view& operator=(const matrix_view& other) {
+        return assign_from(other);
+    }
+
+    template<typename X>
+    matrix_view& operator=(const X& x) {
+        return assign_from(view(x));
+    }
+
+    template<typename X>
+    matrix_view& operator+=(const X& x) {
+        auto s = view(x);
+        static_assert(decltype(s)::rows() == R && decltype(s)::cols() == C,
+                      "matrix_view: shapes differ");
+        if (contiguous() && s.contiguous()) {
+            strided_view_detail::add(m_data, 1, s.data(), 1, R * C);
+        } else {
+            for (size_t i = 0; i < R; ++i)
+                strided_view_detail::add(m_data + ptrdiff_t(i) * m_rs, m_cs,
+                                         s.data() + ptrdiff_t(i) * s.row_stride(),
+                                         s.col_stride(), C);
+        }
+        return *this;
+    }
+
+private:
+    template<typename V>
+    matrix_view& assign_from(const V& s) {
+        static_assert(V::rows() == R && V::cols() == C, "matrix_view: shapes differ");
+        if (contiguous() && s.contiguous()) {
+            strided_view_detail::assign(m_data, 1, s.data(), 1, R * C);
+        } else {
+            for (size_t i = 0; i < R; ++i)
+                strided_view_detail::assign(m_data + ptrdiff_t(i) * m_rs, m_cs,
+                                            s.data() + ptrdiff_t(i) * s.row_stride(),
+                                            s.col_stride(), C);
+        }
+        return *this;
+    }
+
+    T* m_data;
+    ptrdiff_t m_rs, m_cs;
+};
+
+////////////////////////////////////////////////////////////
+// Views of whole objects; views of views are themselves
+template<typename T, size_t N>
+strided_view<T, N> view(vec<T, N>& v) { return strided_view<T, N>(v.data()); }
+
+template<typename T, size_t N>
+strided_view<const T, N> view(const vec<T, N>& v) {
+    return strided_view<const T, N>(v.data());
+}
+
+template<typename T, size_t N>
+strided_view<T, N> view(const strided_view<T, N>& v) { return v; }
+
+// mat<T, N, M> is M rows of N
+template<typename T, size_t N, size_t M>
+matrix_view<T, M, N> view(mat<T, N, M>& m) {
+    return matrix_view<T, M, N>(strided_view_detail::elements(m), N, 1);
+}
+
+template<typename T, size_t N, size_t M>
+matrix_view<const T, M, N> view(const mat<T, N, M>& m) {
+    return matrix_view<const T, M, N>(strided_view_detail::elements(m), N, 1);
+}
+
+template<typename T, size_t R, size_t C>
+matrix_view<T, R, C> view(const matrix_view<T, R, C>& v) { return v; }
+
+////////////////////////////////////////////////////////////
+// The views asked for by name
+
+// row i of m: unit stride
+template<typename Mat>
+auto row(Mat&& m, size_t i) -> decltype(view(m).row(i)) { return view(m).row(i); }
+
+// column j of m: one row apart
+template<typename Mat>
+auto col(Mat&& m, size_t j) -> decltype(view(m).col(j)) { return view(m).col(j); }
+
+template<typename Mat>
+auto transpose(Mat&& m) -> decltype(view(m).transpose()) { return view(m).transpose(); }
+
+// R2 x C2 elements of m starting at row i, column j
+template<size_t R2, size_t C2, typename Mat>
+auto block(Mat&& m, size_t i, size_t j) -> decltype(view(m).template block<R2, C2>(i, j)) {
+    return view(m).template block<R2, C2>(i, j);
+}
+
+// K elements of v: v[start], v[start + step], ...
+template<size_t K, typename T, size_t N>
+strided_view<T, K> slice(vec<T, N>& v, size_t start, size_t step) {
+    return strided_view<T, K>(v.data() + start, ptrdiff_t(step));
+}
+
+template<size_t K, typename T, size_t N>
+strided_view<const T, K> slice(const vec<T, N>& v, size_t start, size_t step) {
+    return strided_view<const T, K>(v.data() + start, ptrdiff_t(step));
+}
+
+#endif
@@ -0,0 +1,213 @@
+//
+//  string_pool.cpp
+//
+//  Created on 10/19/26.
+//
+//  string_pool.h in use, and what interning saves on string keys that
+//  repeat: heap bytes of a million keys held as std::string (as in the
+//  vector<string> of rvalue.cpp) or as handles, the cost of counting and
+//  looking them up in map<string, int> (as in variadic_templates.cpp),
+//  unordered_map<string, int> and interned_map<int>, and interning
+//  throughput from one thread and from several. interned_map wins when
+//  it is searched by handle; searched by string it pays a pool probe on
+//  top of its own and loses to unordered_map<string, int>.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <new>
+#include "string_pool.h"
+
+using namespace std;
+
+// every allocation carries its size in front, so live heap bytes can be
+// read at any point
+static atomic<size_t> heap_bytes(0);
+
+void* operator new(size_t n) {
+    void* p = malloc(n + 16);
+    if (!p)
+        throw bad_alloc();
+    *static_cast<size_t*>(p) = n;
+    heap_bytes.fetch_add(n, memory_order_relaxed);
+    return static_cast<char*>(p) + 16;
+}
+
+// out of line, or GCC sees free() on what operator new returned and warns
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    if (!p)
+        return;
+    char* base = static_cast<char*>(p) - 16;
+    heap_bytes.fetch_sub(*reinterpret_cast<size_t*>(base), memory_order_relaxed);
+    free(base);
+}
+
+void* operator new[](size_t n) { return operator new(n); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+
+template<typename F>
+double time_ms(F f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    chrono::duration<double, milli> ms = chrono::steady_clock::now() - start;
+    return ms.count();
+}
+
+// keys the way a log or a symbol table repeats them: a few thousand
+// distinct names, too long for the short string buffer, drawn a million times
+vector<string> make_keys(size_t distinct, size_t n) {
+    vector<string> names;
+    for (size_t i = 0; i < distinct; ++i)
+        names.push_back("service.request." + to_string(i * 7919 % 100003) + ".latency");
+    mt19937 rng(42);
+    uniform_int_distribution<size_t> pick(0, distinct - 1);
+    vector<string> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        keys.push_back(names[pick(rng)]);
+    return keys;
+}
+
+void row(const string& name, double ms, double base) {
+    cout << setw(36) << name << setw(12) << fixed << setprecision(1) << ms
+         << setw(9) << setprecision(2) << base / ms << "x" << endl;
+}
+
+int main()
+{
+    string_pool pool;
+    interned_string a = pool.intern("hello"), b = pool.intern(string("hel") + "lo");
+    cout << a << " == " << b << ": " << (a == b) << ", same characters: "
+         << (a.data() == b.data()) << endl; // 1, 1
+    cout << "\"\" is the default handle: " << (pool.intern("") == interned_string())
+         << ", pool size " << pool.size() << endl; // 1, 1
+
+    interned_map<int> ages(pool);
+    ages["alice"] = 30;
+    ages[pool.intern("bob")] = 25;
+    cout << "bob " << ages.find("bob")->second << ", carol "
+         << (ages.find("carol") == ages.end() ? "missing" : "found")
+         << ", pool size " << pool.size() << endl; // 25, missing, 3
+
+    /////////////////////////////////////////////////////////
+    const size_t distinct = 2000, n = 1000000;
+    const vector<string> keys = make_keys(distinct, n);
+
+    size_t before = heap_bytes;
+    size_t as_strings;
+    {
+        vector<string> copies(keys);
+        as_strings = heap_bytes - before;
+    }
+    before = heap_bytes;
+    size_t as_handles, pool_bytes;
+    vector<interned_string> handles;
+    {
+        string_pool p;
+        vector<interned_string> h;
+        h.reserve(keys.size());
+        for (const string& k : keys)
+            h.push_back(p.intern(k));
+        as_handles = heap_bytes - before;
+        pool_bytes = p.memory_usage();
+    }
+    cout << n << " keys, " << distinct << " distinct: vector<string> "
+         << as_strings / 1024 << " KiB, vector<interned_string> + pool "
+         << as_handles / 1024 << " KiB (pool " << pool_bytes / 1024 << " KiB)"
+         << endl;
+
+    /////////////////////////////////////////////////////////
+    handles.reserve(keys.size());
+    for (const string& k : keys)
+        handles.push_back(pool.intern(k));
+
+    cout << setw(36) << "counting " + to_string(n) + " keys" << setw(12) << "ms"
+         << setw(10) << "speedup" << endl;
+    long check_map = 0, check_umap = 0, check_handles = 0, check_refs = 0;
+    double t_map = time_ms([&] {
+        map<string, int> m;
+        for (const string& k : keys)
+            ++m[k];
+        for (const string& k : keys)
+            check_map += m.find(k)->second;
+    });
+    double t_umap = time_ms([&] {
+        unordered_map<string, int> m;
+        for (const string& k : keys)
+            ++m[k];
+        for (const string& k : keys)
+            check_umap += m.find(k)->second;
+    });
+    double t_handles = time_ms([&] {
+        interned_map<int> m(pool);
+        for (interned_string k : handles)
+            ++m[k];
+        for (interned_string k : handles)
+            check_handles += m.find(k)->second;
+    });
+    double t_refs = time_ms([&] {
+        interned_map<int> m(pool);
+        for (const string& k : keys)
+            ++m[string_ref(k)];
+        for (const string& k : keys)
+            check_refs += m.find(string_ref(k))->second;
+    });
+    row("map<string, int>", t_map, t_map);
+    row("unordered_map<string, int>", t_umap, t_map);
+    row("interned_map<int>, by handle", t_handles, t_map);
+    row("interned_map<int>, by string", t_refs, t_map);
+    if (check_map != check_umap || check_map != check_handles || check_map != check_refs)
+        cout << "MISMATCH" << endl;
+
+    size_t eq_strings = 0, eq_handles = 0;
+    double t_eq_strings = time_ms([&] {
+        for (size_t i = 1; i < n; ++i)
+            eq_strings += keys[i] == keys[i - 1];
+    });
+    double t_eq_handles = time_ms([&] {
+        for (size_t i = 1; i < n; ++i)
+            eq_handles += handles[i] == handles[i - 1];
+    });
+    row("string ==", t_eq_strings, t_eq_strings);
+    row("interned_string ==", t_eq_handles, t_eq_strings);
+    if (eq_strings != eq_handles)
+        cout << "MISMATCH" << endl;
+
+    /////////////////////////////////////////////////////////
+    // every thread interns all keys into a fresh pool; all must agree
+    const unsigned threads = max(2u, thread::hardware_concurrency());
+    string_pool one;
+    double t_one = time_ms([&] {
+        for (const string& k : keys)
+            one.intern(k);
+    });
+    string_pool shared;
+    vector<vector<interned_string>> seen(threads);
+    double t_many = time_ms([&] {
+        vector<thread> workers;
+        for (unsigned t = 0; t < threads; ++t)
+            workers.emplace_back([&, t] {
+                seen[t].reserve(keys.size());
+                for (size_t i = 0; i < keys.size(); ++i)
+                    seen[t].push_back(shared.intern(keys[(i + t * 7777) % keys.size()]));
+            });
+        for (thread& w : workers)
+            w.join();
+    });
+    bool agree = shared.size() == distinct;
+    for (unsigned t = 1; t < threads; ++t)
+        for (size_t i = 0; i < keys.size(); ++i)
+            agree = agree && seen[t][i] == seen[0][(i + t * 7777) % keys.size()];
+    cout << "interning " << n << " keys: 1 thread " << fixed << setprecision(1)
+         << n / t_one / 1000 << " M/s, " << threads << " threads "
+         << threads * n / t_many / 1000 << " M/s"
+         << (agree ? "" : ", MISMATCH") << endl;
+}
@@ -0,0 +1,351 @@
+//
+//  string_pool.h
+//
+//  Created on 10/19/26.
+//  https://en.wikipedia.org/wiki/String_interning
+//  https://preshing.com/20130605/the-worlds-simplest-lock-free-hash-table/
+//
+//  Interned strings. A string_pool keeps one copy of every distinct string
+//  in arena chunks, next to its length and hash, and hands out an
+//  interned_string: a single pointer to that copy. Two handles from the
+//  same pool are equal exactly when their pointers are, their hash is
+//  read rather than computed, and their characters never move or die
+//  before the pool does.
+//
+//  The pool is split into shards by hash. Lookups probe a shard's
+//  open-addressing table without locking; only inserting a new string
+//  takes the shard's mutex. Tables replaced on growth stay allocated until
+//  the pool is destroyed, so a reader still probing one is never left
+//  with a dangling table.
+
+#ifndef STRING_POOL_H
+#define STRING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "hash_bytes.h"
+#include "string_ref.h"
+
+namespace string_pool_detail {
+
+using hash_detail::hash_bytes;
+
+// followed in the arena by the characters and a '\0'
+struct entry {
+    uint64_t hash;
+    size_t size;
+    const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+};
+
+// the empty string belongs to no pool, so that every pool agrees on it
+inline const entry* empty_entry() {
+    static const struct {
+        entry e;
+        char nul;
+    } empty = { { hash_bytes("", 0), 0 }, '\0' };
+    return &empty.e;
+}
+
+} // namespace string_pool_detail
+
+////////////////////////////////////////////////////////////
+class interned_string {
+public:
+    interned_string() : m_entry(string_pool_detail::empty_entry()) { }
+
+    const char* data() const { return m_entry->data(); }
+    const char* c_str() const { return m_entry->data(); }
+    size_t size() const { return m_entry->size; }
+    bool empty() const { return m_entry->size == 0; }
+    uint64_t hash() const { return m_entry->hash; }
+    string_ref view() const { return string_ref(data(), size()); }
+    operator string_ref() const { return view(); }
+    std::string str() const { return std::string(data(), size()); }
+
+    // handles from one pool: same characters, same pointer
+    friend bool operator==(interned_string a, interned_string b)
+        { return a.m_entry == b.m_entry; }
+    friend bool operator!=(interned_string a, interned_string b)
+        { return a.m_entry != b.m_entry; }
+    // alphabetical, so ordered containers print in the usual order
+    friend bool operator<(interned_string a, interned_string b)
+        { return a.m_entry != b.m_entry && a.view() < b.view(); }
+
+private:
+    friend class string_pool;
+    explicit interned_string(const string_pool_detail::entry* e) : m_entry(e) { }
+
+    const string_pool_detail::entry* m_entry;
+};
+
+inline std::ostream& operator<<(std::ostream& os, interned_string s) {
+    return os << s.view();
+}
+
+struct interned_hash {
+    size_t operator()(interned_string s) const { return size_t(s.hash()); }
+};
+
+namespace std {
+template<> struct hash<interned_string> : interned_hash { };
+}
+
+////////////////////////////////////////////////////////////
+class string_pool {
+public:
+    enum { shard_count = 16, chunk_size = 64 * 1024, initial_slots = 64, };
+
+    string_pool() { }
+    string_pool(const string_pool&) = delete;
+    string_pool& operator=(const string_pool&) = delete;
+
+    interned_string intern(string_ref s) {
+        if (s.empty())
+            return interned_string();
+        const uint64_t h = string_pool_detail::hash_bytes(s.data(), s.size());
+        shard& sh = shard_of(h);
+        if (const entry* e = probe(sh.current.load(std::memory_order_acquire), h, s))
+            return interned_string(e);
+
+        std::lock_guard<std::mutex> lock(sh.mutex);
+        table* t = sh.current.load(std::memory_order_relaxed);
+        if (const entry* e = probe(t, h, s))
+            return interned_string(e);
+        if (!t || (sh.count.load(std::memory_order_relaxed) + 1) * 2 > t->mask + 1)
+            t = grow(sh, t);
+        const entry* e = allocate(sh, h, s);
+        place(t, e);
+        sh.count.fetch_add(1, std::memory_order_relaxed);
+        return interned_string(e);
+    }
+
+    // Looks s up without adding it; lookups by strings that were never
+    // interned cannot match any handle anyway.
+    bool find(string_ref s, interned_string& out) const {
+        if (s.empty()) {
+            out = interned_string();
+            return true;
+        }
+        const uint64_t h = string_pool_detail::hash_bytes(s.data(), s.size());
+        const shard& sh = m_shards[h >> 60];
+        const entry* e = probe(sh.current.load(std::memory_order_acquire), h, s);
+        if (e)
+            out = interned_string(e);
+        return e != nullptr;
+    }
+
+    // distinct non-empty strings
+    size_t size() const {
+        size_t n = 0;
+        for (const shard& sh : m_shards)
+            n += sh.count.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    // bytes held in arena chunks and in hash tables, retired ones included
+    size_t memory_usage() const {
+        size_t bytes = sizeof(*this);
+        for (const shard& sh : m_shards) {
+            std::lock_guard<std::mutex> lock(sh.mutex);
+            bytes += sh.arena_bytes;
+            for (const auto& t : sh.tables)
+                bytes += sizeof(table) + (t->mask + 1) * sizeof(t->slots[0]);
+        }
+        return bytes;
+    }
+
+private:
+    typedef string_pool_detail::entry entry;
+
+    struct table {
+        explicit table(size_t slots)
+            : mask(slots - 1), slots(new std::atomic<const entry*>[slots]()) { }
+        size_t mask;
+        std::unique_ptr<std::atomic<const entry*>[]> slots;
+    };
+
+    struct shard {
+        shard() : current(nullptr), count(0), next(nullptr), left(0),
+                  arena_bytes(0) { }
+        mutable std::mutex mutex;
+        std::atomic<table*> current;
+        std::atomic<size_t> count;
+        // written under the mutex only
+        std::vector<std::unique_ptr<table>> tables;
+        std::vector<std::unique_ptr<char[]>> chunks;
+        char* next;
+        size_t left;
+        size_t arena_bytes;
+        char pad[64];  // keeps neighbouring shards off each other's lines
+    };
+
+    shard& shard_of(uint64_t h) { return m_shards[h >> 60]; }
+
+    static const entry* probe(const table* t, uint64_t h, string_ref s) {
+        if (!t)
+            return nullptr;
+        for (size_t i = h & t->mask;; i = (i + 1) & t->mask) {
+            const entry* e = t->slots[i].load(std::memory_order_acquire);
+            if (!e)
+                return nullptr;
+            if (e->hash == h && e->size == s.size() &&
+                    std::memcmp(e->data(), s.data(), s.size()) == 0)
+                return e;
+        }
+    }
+
+    static void place(table* t, const entry* e) {
+        size_t i = e->hash & t->mask;
+        while (t->slots[i].load(std::memory_order_relaxed))
+            i = (i + 1) & t->mask;
+        t->slots[i].store(e, std::memory_order_release);
+    }
+
+    // doubles the table; the old one stays readable for concurrent probes
+    static table* grow(shard& sh, table* old) {
+        std::unique_ptr<table> t(new table(old ? 2 * (old->mask + 1)
+                                               : size_t(initial_slots)));
+        if (old)
+            for (size_t i = 0; i <= old->mask; ++i)
+                if (const entry* e = old->slots[i].load(std::memory_order_relaxed))
+                    place(t.get(), e);
+        sh.tables.push_back(std::move(t));
+        sh.current.store(sh.tables.back().get(), std::memory_order_release);
+        return sh.tables.back().get();
+    }
+
+    static const entry* allocate(shard& sh, uint64_t h, string_ref s) {
+        const size_t align = alignof(entry);
+        const size_t bytes = (sizeof(entry) + s.size() + 1 + align - 1) & ~(align - 1);
+        if (bytes > sh.left) {
+            const size_t n = std::max(bytes, size_t(chunk_size));
+            sh.chunks.push_back(std::unique_ptr<char[]>(new char[n]));
+            sh.next = sh.chunks.back().get();
+            sh.left = n;
+            sh.arena_bytes += n;
+        }
+        entry* e = ::new (sh.next) entry{ h, s.size() };
+        char* chars = sh.next + sizeof(entry);
+        std::memcpy(chars, s.data(), s.size());
+        chars[s.size()] = '\0';
+        sh.next += bytes;
+        sh.left -= bytes;
+        return e;
+    }
+
+    shard m_shards[shard_count];
+};
+
+// The process-wide pool
+inline string_pool& default_string_pool() {
+    static string_pool pool;
+    return pool;
+}
+
+inline interned_string intern(string_ref s) {
+    return default_string_pool().intern(s);
+}
+
+////////////////////////////////////////////////////////////
+// Containers keyed by handles. Keys given as strings are interned when
+// inserted and only looked up when searched for, so a search for a
+// string nobody inserted costs one probe and never grows the pool.
+//
+// Only lookups by handle beat an unordered_map<std::string, V>: they
+// hash nothing and compare pointers. A lookup by string hashes and probes
+// the pool for the handle and then probes the map with it, two probes
+// where the unordered_map makes one, and is slower. Intern keys once and
+// keep the handles where the same keys are looked up again and again.
+template<typename V>
+class interned_map {
+public:
+    typedef std::unordered_map<interned_string, V, interned_hash> map_type;
+    typedef typename map_type::value_type value_type;
+    typedef typename map_type::iterator iterator;
+    typedef typename map_type::const_iterator const_iterator;
+
+    explicit interned_map(string_pool& pool = default_string_pool())
+        : m_pool(&pool) { }
+
+    V& operator[](interned_string k) { return m_map[k]; }
+    V& operator[](string_ref k) { return m_map[m_pool->intern(k)]; }
+
+    iterator find(interned_string k) { return m_map.find(k); }
+    const_iterator find(interned_string k) const { return m_map.find(k); }
+    iterator find(string_ref k) {
+        interned_string h;
+        return m_pool->find(k, h) ? m_map.find(h) : m_map.end();
+    }
+    const_iterator find(string_ref k) const {
+        interned_string h;
+        return m_pool->find(k, h) ? m_map.find(h) : m_map.end();
+    }
+
+    size_t count(interned_string k) const { return m_map.count(k); }
+    size_t count(string_ref k) const { return find(k) == end() ? 0 : 1; }
+    size_t erase(interned_string k) { return m_map.erase(k); }
+    size_t erase(string_ref k) {
+        interned_string h;
+        return m_pool->find(k, h) ? m_map.erase(h) : 0;
+    }
+
+    size_t size() const { return m_map.size(); }
+    bool empty() const { return m_map.empty(); }
+    void clear() { m_map.clear(); }
+    iterator begin() { return m_map.begin(); }
+    iterator end() { return m_map.end(); }
+    const_iterator begin() const { return m_map.begin(); }
+    const_iterator end() const { return m_map.end(); }
+
+private:
+    string_pool* m_pool;
+    map_type m_map;
+};
+
+class interned_set {
+public:
+    typedef std::unordered_set<interned_string, interned_hash> set_type;
+    typedef set_type::const_iterator const_iterator;
+    typedef const_iterator iterator;
+
+    explicit interned_set(string_pool& pool = default_string_pool())
+        : m_pool(&pool) { }
+
+    bool insert(interned_string k) { return m_set.insert(k).second; }
+    bool insert(string_ref k) { return m_set.insert(m_pool->intern(k)).second; }
+
+    size_t count(interned_string k) const { return m_set.count(k); }
+    size_t count(string_ref k) const {
+        interned_string h;
+        return m_pool->find(k, h) ? m_set.count(h) : 0;
+    }
+    size_t erase(interned_string k) { return m_set.erase(k); }
+    size_t erase(string_ref k) {
+        interned_string h;
+        return m_pool->find(k, h) ? m_set.erase(h) : 0;
+    }
+
+    size_t size() const { return m_set.size(); }
+    bool empty() const { return m_set.empty(); }
+    void clear() { m_set.clear(); }
+    const_iterator begin() const { return m_set.begin(); }
+    const_iterator end() const { return m_set.end(); }
+
+private:
+    string_pool* m_pool;
+    set_type m_set;
+};
+
+#endif
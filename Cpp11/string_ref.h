@@ -0,0 +1,55 @@
+//
+//  string_ref.h
+//
+//  Created on 10/19/26.
+//  http://en.cppreference.com/w/cpp/string/basic_string_view
+//
+//  string_ref from string_pool.h, on its own so that tagged_value.h can
+//  hand out views of its strings without pulling in the pool.
+
+#ifndef STRING_REF_H
+#define STRING_REF_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+// A view of characters owned elsewhere; C++11 has no std::string_view
+class string_ref {
+public:
+    string_ref() : m_data(""), m_size(0) { }
+    string_ref(const char* s) : m_data(s), m_size(std::strlen(s)) { }
+    string_ref(const char* s, size_t n) : m_data(s), m_size(n) { }
+    string_ref(const std::string& s) : m_data(s.data()), m_size(s.size()) { }
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const char* begin() const { return m_data; }
+    const char* end() const { return m_data + m_size; }
+    char operator[](size_t i) const { return m_data[i]; }
+    std::string str() const { return std::string(m_data, m_size); }
+
+private:
+    const char* m_data;
+    size_t m_size;
+};
+
+inline bool operator==(string_ref a, string_ref b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+}
+
+inline bool operator!=(string_ref a, string_ref b) { return !(a == b); }
+
+inline bool operator<(string_ref a, string_ref b) {
+    int c = std::memcmp(a.data(), b.data(), std::min(a.size(), b.size()));
+    return c < 0 || (c == 0 && a.size() < b.size());
+}
+
+inline std::ostream& operator<<(std::ostream& os, string_ref s) {
+    return os.write(s.data(), std::streamsize(s.size()));
+}
+
+#endif
@@ -0,0 +1,283 @@
+//
+//  tagged_value.cpp
+//
+//  Created on 10/19/26.
+//
+//  tagged_value.h in use, and 100M runtime-typed values dispatched to
+//  the code for their type: through visit, through the if/else chain on a
+//  kind field we would otherwise write, and through virtual calls on heap
+//  boxes. Pairs are dispatched by one visit on both values and by a visit
+//  nested in another. Built with SPECIAL_FLAGS=-std=c++17 the table also
+//  has std::variant and std::visit, which C++11 does not have.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include "tagged_value.h"
+#if __cplusplus >= 201703L
+#include <variant>
+#endif
+
+using namespace std;
+
+template<typename F>
+double time_ns(F f, size_t ops) {
+    auto start = chrono::steady_clock::now();
+    f();
+    chrono::duration<double, nano> ns = chrono::steady_clock::now() - start;
+    return ns.count() / double(ops);
+}
+
+// what every dispatch computes for a value
+struct checksum {
+    uint64_t operator()(null_value) const { return 1; }
+    uint64_t operator()(int64_t i) const { return uint64_t(i); }
+    uint64_t operator()(double d) const { return uint64_t(int64_t(d * 4)); }
+    uint64_t operator()(const void* p) const { return uintptr_t(p) >> 4; }
+    uint64_t operator()(string_ref s) const { return s.size() + (unsigned char)s[0]; }
+#if __cplusplus >= 201703L
+    uint64_t operator()(monostate) const { return 1; }
+    uint64_t operator()(const string& s) const { return (*this)(string_ref(s)); }
+#endif
+};
+
+struct combine {
+    template<typename A, typename B>
+    uint64_t operator()(A a, B b) const { return checksum()(a) * 3 + checksum()(b); }
+};
+
+// the second half of a nested visit
+template<typename A>
+struct combine_with {
+    A a;
+    template<typename B>
+    uint64_t operator()(B b) const { return combine()(a, b); }
+};
+
+struct combine_nested {
+    const tagged_value& b;
+    template<typename A>
+    uint64_t operator()(A a) const { return visit(combine_with<A>{ a }, b); }
+};
+
+/////////////////////////////////////////////////////////////
+// what we would write without tagged_value.h
+struct plain_value {
+    value_kind kind;
+    int64_t i;
+    double f;
+    const void* p;
+    string s;
+};
+
+uint64_t chain(const plain_value& v) {
+    if (v.kind == kind_integer)
+        return checksum()(v.i);
+    else if (v.kind == kind_floating)
+        return checksum()(v.f);
+    else if (v.kind == kind_pointer)
+        return checksum()(v.p);
+    else if (v.kind == kind_string)
+        return checksum()(string_ref(v.s));
+    else
+        return checksum()(null_value());
+}
+
+struct boxed {
+    virtual ~boxed() { }
+    virtual uint64_t sum() const = 0;
+};
+
+template<typename T>
+struct box : boxed {
+    explicit box(T x) : value(x) { }
+    uint64_t sum() const { return checksum()(value); }
+    T value;
+};
+
+template<>
+struct box<string> : boxed {
+    explicit box(string s) : value(s) { }
+    uint64_t sum() const { return checksum()(string_ref(value)); }
+    string value;
+};
+
+struct none_box : boxed {
+    uint64_t sum() const { return checksum()(null_value()); }
+};
+
+/////////////////////////////////////////////////////////////
+const size_t n = 1000000;
+const int rounds = 100;
+
+struct row_printer {
+    uint64_t expected;
+    bool ok;
+    void operator()(const char* name, double ns, size_t bytes, uint64_t sum) {
+        cout << setw(28) << name << fixed << setprecision(2) << setw(10) << ns
+             << setw(8) << bytes << endl;
+        ok = ok && sum == expected;
+    }
+};
+
+int main()
+{
+    tagged_value a = 42, b = 2.5, c = string("a string"), d;
+    cout << a << ", " << b << ", " << c << ", " << d << ", sizeof "
+         << sizeof(tagged_value) << endl; // 42, 2.5, a string, null, 24
+    cout << "a + b = " << visit(combine(), a, b) << endl; // 42 * 3 + 10
+    try {
+        c.as_integer();
+    } catch (const invalid_argument& e) {
+        cout << e.what() << endl;
+    }
+
+    /////////////////////////////////////////////////////////
+    const char* words[] = { "id", "name", "timestamp", "a longer string kept on the heap",
+                            "x", "another string over sixteen characters" };
+    static int targets[64];
+    vector<tagged_value> values;
+    vector<plain_value> plain;
+    vector<unique_ptr<boxed>> boxes;
+    values.reserve(n);
+    plain.reserve(n);
+    boxes.reserve(n);
+#if __cplusplus >= 201703L
+    vector<variant<monostate, int64_t, double, const void*, string>> variants;
+    variants.reserve(n);
+#endif
+    uint64_t seed = 1;
+    for (size_t i = 0; i < n; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        int64_t x = int64_t(i);
+        // mostly numbers, some pointers and strings, a few empty values
+        switch ((seed >> 33) % 16) {
+        case 0: case 1: case 2: case 3: case 4: case 5:
+            values.push_back(x);
+            plain.push_back(plain_value{ kind_integer, x, 0, nullptr, string() });
+            boxes.emplace_back(new box<int64_t>(x));
+#if __cplusplus >= 201703L
+            variants.emplace_back(x);
+#endif
+            break;
+        case 6: case 7: case 8: case 9: {
+            double f = double(x) * 0.5;
+            values.push_back(f);
+            plain.push_back(plain_value{ kind_floating, 0, f, nullptr, string() });
+            boxes.emplace_back(new box<double>(f));
+#if __cplusplus >= 201703L
+            variants.emplace_back(f);
+#endif
+            break;
+        }
+        case 10: case 11: case 12: {
+            const void* p = &targets[i % 64];
+            values.push_back(p);
+            plain.push_back(plain_value{ kind_pointer, 0, 0, p, string() });
+            boxes.emplace_back(new box<const void*>(p));
+#if __cplusplus >= 201703L
+            variants.emplace_back(p);
+#endif
+            break;
+        }
+        case 13: case 14: {
+            string s = words[i % 6];
+            values.push_back(s);
+            plain.push_back(plain_value{ kind_string, 0, 0, nullptr, s });
+            boxes.emplace_back(new box<string>(s));
+#if __cplusplus >= 201703L
+            variants.emplace_back(s);
+#endif
+            break;
+        }
+        default:
+            values.push_back(tagged_value());
+            plain.push_back(plain_value{ kind_none, 0, 0, nullptr, string() });
+            boxes.emplace_back(new none_box);
+#if __cplusplus >= 201703L
+            variants.emplace_back();
+#endif
+        }
+    }
+
+    uint64_t expected = 0;
+    for (const tagged_value& v : values)
+        expected += visit(checksum(), v);
+    row_printer row{ expected * rounds, true };
+
+    cout << n * rounds / 1000000 << "M values, their kinds in random order" << endl;
+    cout << setw(28) << "dispatch" << setw(10) << "ns each" << setw(8) << "bytes"
+         << endl;
+    uint64_t sum = 0;
+    double ns = time_ns([&] {
+        for (int r = 0; r < rounds; ++r)
+            for (const tagged_value& v : values)
+                sum += visit(checksum(), v);
+    }, n * rounds);
+    row("visit", ns, sizeof(tagged_value), sum);
+
+    sum = 0;
+    ns = time_ns([&] {
+        for (int r = 0; r < rounds; ++r)
+            for (const plain_value& v : plain)
+                sum += chain(v);
+    }, n * rounds);
+    row("if/else chain", ns, sizeof(plain_value), sum);
+
+    sum = 0;
+    ns = time_ns([&] {
+        for (int r = 0; r < rounds; ++r)
+            for (const unique_ptr<boxed>& v : boxes)
+                sum += v->sum();
+    }, n * rounds);
+    row("virtual call", ns, sizeof(void*) + sizeof(box<int64_t>), sum);
+
+#if __cplusplus >= 201703L
+    sum = 0;
+    ns = time_ns([&] {
+        for (int r = 0; r < rounds; ++r)
+            for (const auto& v : variants)
+                sum += std::visit(checksum(), v);
+    }, n * rounds);
+    row("std::visit", ns, sizeof(variants[0]), sum);
+#endif
+
+    /////////////////////////////////////////////////////////
+    expected = 0;
+    for (size_t i = 0; i + 1 < n; i += 2)
+        expected += visit(combine(), values[i], values[i + 1]);
+    row.expected = expected * rounds;
+
+    sum = 0;
+    ns = time_ns([&] {
+        for (int r = 0; r < rounds; ++r)
+            for (size_t i = 0; i + 1 < n; i += 2)
+                sum += visit(combine(), values[i], values[i + 1]);
+    }, n / 2 * rounds);
+    row("visit, pairs", ns, 2 * sizeof(tagged_value), sum);
+
+    sum = 0;
+    ns = time_ns([&] {
+        for (int r = 0; r < rounds; ++r)
+            for (size_t i = 0; i + 1 < n; i += 2)
+                sum += visit(combine_nested{ values[i + 1] }, values[i]);
+    }, n / 2 * rounds);
+    row("nested visit, pairs", ns, 2 * sizeof(tagged_value), sum);
+
+#if __cplusplus >= 201703L
+    sum = 0;
+    ns = time_ns([&] {
+        for (int r = 0; r < rounds; ++r)
+            for (size_t i = 0; i + 1 < n; i += 2)
+                sum += std::visit(combine(), variants[i], variants[i + 1]);
+    }, n / 2 * rounds);
+    row("std::visit, pairs", ns, 2 * sizeof(variants[0]), sum);
+#endif
+
+    if (!row.ok)
+        cout << "MISMATCH" << endl;
+}
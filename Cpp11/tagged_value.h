@@ -0,0 +1,355 @@
+//
+//  tagged_value.h
+//
+//  Created on 10/19/26.
+//  http://en.cppreference.com/w/cpp/utility/variant
+//  https://mpark.github.io/programming/2019/01/22/variant-visitation-v2/
+//
+//  A value whose type is only known at run time: nothing, an integer, a
+//  floating point number, a pointer or a string. What a C++ type becomes
+//  is decided by the enable_if tests what_am_i in enable_if.cpp overloads
+//  on, gathered in value_trait: every integral type is stored as an
+//  int64_t, every floating point type as a double and every object
+//  pointer, char pointers included, as a const void*; std::string and
+//  string_ref make a string. A tagged_value is 24 bytes. Strings of up to
+//  16 characters are kept inline, longer ones are copied to the heap.
+//
+//  visit(f, v) calls f with what v holds, as the null_value, int64_t,
+//  double, const void* or string_ref it is. One switch on the tag picks
+//  the call: it compiles to a single jump through a table, with f's
+//  overloads inlined into the cases, instead of a chain of compares or a
+//  virtual call. visit(f, a, b, ...) picks f's overload for all the tags
+//  at once, through one table of 5^n calls indexed by the tags together.
+
+#ifndef TAGGED_VALUE_H
+#define TAGGED_VALUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "indices.h"
+#include "string_ref.h"
+
+enum value_kind {
+    kind_none,
+    kind_integer,
+    kind_floating,
+    kind_pointer,
+    kind_string,
+};
+
+// what an empty tagged_value is visited with
+struct null_value { };
+
+inline bool operator==(null_value, null_value) { return true; }
+inline bool operator!=(null_value, null_value) { return false; }
+
+inline std::ostream& operator<<(std::ostream& os, null_value) {
+    return os << "null";
+}
+
+////////////////////////////////////////////////////////////
+// The alternative a T is stored as, chosen as what_am_i chooses
+template<typename T, typename Enable = void>
+struct value_trait { enum { is_value = false, }; };
+
+template<typename T>
+struct value_trait<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+    enum { is_value = true, kind = kind_integer, };
+    typedef int64_t type;
+};
+
+template<typename T>
+struct value_trait<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    enum { is_value = true, kind = kind_floating, };
+    typedef double type;
+};
+
+template<typename T>
+struct value_trait<T, typename std::enable_if<std::is_pointer<T>::value &&
+    !std::is_function<typename std::remove_pointer<T>::type>::value>::type> {
+    enum { is_value = true, kind = kind_pointer, };
+    typedef const void* type;
+};
+
+template<>
+struct value_trait<std::string> {
+    enum { is_value = true, kind = kind_string, };
+    typedef string_ref type;
+};
+
+template<>
+struct value_trait<string_ref> {
+    enum { is_value = true, kind = kind_string, };
+    typedef string_ref type;
+};
+
+template<>
+struct value_trait<null_value> {
+    enum { is_value = true, kind = kind_none, };
+    typedef null_value type;
+};
+
+namespace tagged_value_detail {
+
+template<size_t K> struct alternative;
+
+} // namespace tagged_value_detail
+
+////////////////////////////////////////////////////////////
+class tagged_value {
+    template<typename T>
+    using trait = value_trait<typename std::decay<T>::type>;
+
+public:
+    static const size_t small_capacity = 16;
+
+    tagged_value() : m_u(), m_kind(kind_none), m_small(0) { }
+
+    template<typename T, typename = typename std::enable_if<trait<T>::is_value>::type>
+    tagged_value(const T& x) : m_u(), m_kind(kind_none), m_small(0) {
+        set(static_cast<typename trait<T>::type>(x));
+    }
+
+    tagged_value(const tagged_value& other) : m_u(), m_kind(kind_none), m_small(0) {
+        if (other.on_heap())
+            set(other.str_view());
+        else
+            steal(other);
+    }
+
+    tagged_value(tagged_value&& other) noexcept : m_kind(kind_none), m_small(0) {
+        steal(other);
+        other.m_kind = kind_none;
+    }
+
+    ~tagged_value() { reset(); }
+
+    tagged_value& operator=(const tagged_value& other) {
+        if (this != &other) {
+            tagged_value tmp(other);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    tagged_value& operator=(tagged_value&& other) noexcept {
+        if (this != &other) {
+            reset();
+            steal(other);
+            other.m_kind = kind_none;
+        }
+        return *this;
+    }
+
+    value_kind kind() const { return value_kind(m_kind); }
+    bool empty() const { return m_kind == kind_none; }
+
+    // throw std::invalid_argument when the value is of another kind
+    int64_t as_integer() const { check(kind_integer, "an integer"); return m_u.i; }
+    double as_floating() const { check(kind_floating, "a floating point number"); return m_u.f; }
+    const void* as_pointer() const { check(kind_pointer, "a pointer"); return m_u.p; }
+    string_ref as_string() const { check(kind_string, "a string"); return str_view(); }
+
+    void swap(tagged_value& other) noexcept {
+        tagged_value tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    template<size_t K> friend struct tagged_value_detail::alternative;
+
+    // m_small when the characters are on the heap
+    static const unsigned char heap = 0xFF;
+
+    bool on_heap() const { return m_kind == kind_string && m_small == heap; }
+
+    string_ref str_view() const {
+        return m_small == heap ? string_ref(m_u.str.data, m_u.str.size)
+                               : string_ref(m_u.chars, m_small);
+    }
+
+    void check(value_kind k, const char* what) const {
+        if (m_kind != k)
+            throw std::invalid_argument(std::string("tagged_value: not ") + what);
+    }
+
+    // *this is empty
+    void set(null_value) { }
+    void set(int64_t i) { m_u.i = i; m_kind = kind_integer; }
+    void set(double f) { m_u.f = f; m_kind = kind_floating; }
+    void set(const void* p) { m_u.p = p; m_kind = kind_pointer; }
+    void set(string_ref s) {
+        if (s.size() <= small_capacity) {
+            std::memcpy(m_u.chars, s.data(), s.size());
+            m_small = (unsigned char)s.size();
+        } else {
+            m_u.str.data = new char[s.size()];
+            std::memcpy(m_u.str.data, s.data(), s.size());
+            m_u.str.size = s.size();
+            m_small = heap;
+        }
+        m_kind = kind_string;
+    }
+
+    // *this is empty; takes other's bytes, heap characters included
+    void steal(const tagged_value& other) {
+        std::memcpy(&m_u, &other.m_u, sizeof(m_u));
+        m_kind = other.m_kind;
+        m_small = other.m_small;
+    }
+
+    void reset() {
+        if (on_heap())
+            delete[] m_u.str.data;
+        m_kind = kind_none;
+    }
+
+    union {
+        int64_t i;
+        double f;
+        const void* p;
+        struct {
+            char* data;
+            size_t size;
+        } str;
+        char chars[small_capacity];
+    } m_u;
+    unsigned char m_kind;
+    unsigned char m_small; // inline string length, or heap
+};
+
+inline void swap(tagged_value& a, tagged_value& b) noexcept { a.swap(b); }
+
+namespace tagged_value_detail {
+
+template<>
+struct alternative<kind_none> {
+    static null_value get(const tagged_value&) { return null_value(); }
+};
+
+template<>
+struct alternative<kind_integer> {
+    static int64_t get(const tagged_value& v) { return v.m_u.i; }
+};
+
+template<>
+struct alternative<kind_floating> {
+    static double get(const tagged_value& v) { return v.m_u.f; }
+};
+
+template<>
+struct alternative<kind_pointer> {
+    static const void* get(const tagged_value& v) { return v.m_u.p; }
+};
+
+template<>
+struct alternative<kind_string> {
+    static string_ref get(const tagged_value& v) { return v.str_view(); }
+};
+
+const size_t kinds = kind_string + 1;
+
+// digit p, counted from the least significant, of i written in base kinds
+constexpr size_t digit(size_t i, size_t p) {
+    return p == 0 ? i % kinds : digit(i / kinds, p - 1);
+}
+
+constexpr size_t cells(size_t n) { return n == 0 ? 1 : kinds * cells(n - 1); }
+
+inline size_t flat_index(size_t index) { return index; }
+
+template<typename... Vs>
+size_t flat_index(size_t index, const tagged_value& v, const Vs&... vs) {
+    return flat_index(index * kinds + v.kind(), vs...);
+}
+
+// what the result type is asked for with, one per value
+template<typename V> using integer_for = int64_t;
+
+// Vs... are all tagged_value; cell I calls f with the alternatives whose
+// kinds are the digits of I, the first value's the most significant
+template<typename R, typename F, typename... Vs>
+struct dispatch {
+    typedef R (*cell)(F& f, const Vs&... vs);
+
+    template<size_t I, size_t... Pos>
+    static R call(F& f, const Vs&... vs) {
+        return f(alternative<digit(I, sizeof...(Vs) - 1 - Pos)>::get(vs)...);
+    }
+
+    template<size_t... Is, size_t... Pos>
+    static R run(indices<Is...>, indices<Pos...>, F& f, const Vs&... vs) {
+        static const cell table[] = { &dispatch::call<Is, Pos...>... };
+        return table[flat_index(0, vs...)](f, vs...);
+    }
+};
+
+} // namespace tagged_value_detail
+
+////////////////////////////////////////////////////////////
+// f needs an overload for each alternative, all returning the same type
+template<typename F>
+auto visit(F&& f, const tagged_value& v) -> decltype(f(int64_t())) {
+    using namespace tagged_value_detail;
+    // no kind outside the five, so GCC drops the range check and jumps
+    // through one table; with a reachable default it compares its way there
+    switch (v.kind()) {
+    case kind_integer:  return f(alternative<kind_integer>::get(v));
+    case kind_floating: return f(alternative<kind_floating>::get(v));
+    case kind_pointer:  return f(alternative<kind_pointer>::get(v));
+    case kind_string:   return f(alternative<kind_string>::get(v));
+    case kind_none:     return f(alternative<kind_none>::get(v));
+    default:            __builtin_unreachable();
+    }
+}
+
+template<typename F, typename... Vs>
+auto visit(F&& f, const tagged_value& a, const tagged_value& b, const Vs&... vs)
+    -> decltype(f(int64_t(), int64_t(), tagged_value_detail::integer_for<Vs>()...)) {
+    typedef decltype(f(int64_t(), int64_t(), tagged_value_detail::integer_for<Vs>()...)) result;
+    typedef typename std::remove_reference<F>::type functor;
+    using namespace tagged_value_detail;
+    const size_t n = 2 + sizeof...(Vs);
+    return dispatch<result, functor, tagged_value, tagged_value, Vs...>::run(
+        make_indices<cells(n)>(), make_indices<n>(), f, a, b, vs...);
+}
+
+////////////////////////////////////////////////////////////
+namespace tagged_value_detail {
+
+struct equal_to {
+    template<typename T>
+    bool operator()(T x, T y) const { return x == y; }
+    template<typename T, typename U>
+    bool operator()(T, U) const { return false; }
+};
+
+struct printer {
+    std::ostream& os;
+    template<typename T>
+    void operator()(T x) const { os << x; }
+};
+
+} // namespace tagged_value_detail
+
+inline bool operator==(const tagged_value& a, const tagged_value& b) {
+    return visit(tagged_value_detail::equal_to(), a, b);
+}
+
+inline bool operator!=(const tagged_value& a, const tagged_value& b) {
+    return !(a == b);
+}
+
+inline std::ostream& operator<<(std::ostream& os, const tagged_value& v) {
+    visit(tagged_value_detail::printer{ os }, v);
+    return os;
+}
+
+#endif
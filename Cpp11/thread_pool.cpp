@@ -0,0 +1,130 @@
+//
+//  thread_pool.cpp
+//
+//  Created on 10/19/26.
+//
+//  thread_pool.h in use: perfectly forwarded submit(), futures, and a
+//  scaling benchmark of parallel_reduce / parallel_for from one thread to
+//  every hardware thread.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <stdexcept>
+#include "thread_pool.h"
+
+using namespace std;
+
+int g_copyConstructCount = 0;
+int g_moveConstructCount = 0;
+
+struct A
+{
+    A() { }
+    A(const A&) { ++g_copyConstructCount; }
+    A(A&&) { ++g_moveConstructCount; }
+};
+
+int take_a(const A&) { return 42; }
+
+///////////////////////////////////////////////////////////////////////////////
+// Compute-bound work for the benchmark
+///////////////////////////////////////////////////////////////////////////////
+inline uint64_t mix(uint64_t x) {
+    for (int r = 0; r < 8; ++r) {
+        x ^= x >> 31;
+        x *= 0x9E3779B97F4A7C15ull;
+    }
+    return x;
+}
+
+struct vec3 {
+    double x, y, z;
+};
+
+inline vec3 operator+(const vec3& a, const vec3& b) {
+    return vec3{ a.x + b.x, a.y + b.y, a.z + b.z };
+}
+
+template<typename F>
+double time_ms(F f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    chrono::duration<double, milli> ms = chrono::steady_clock::now() - start;
+    return ms.count();
+}
+
+int main()
+{
+    thread_pool pool;
+
+    future<int> f1 = pool.submit([](int a, int b) { return a + b; }, 40, 2);
+    cout << "40 + 2 = " << f1.get() << endl;
+
+    A a;
+    pool.submit(take_a, std::move(a)).get();
+    cout << "rvalue argument: " << g_copyConstructCount << " copies, "
+         << g_moveConstructCount << " moves" << endl; // 0 copies
+    pool.submit(take_a, a).get();
+    cout << "lvalue argument: " << g_copyConstructCount << " copies" << endl; // 1
+
+    unique_ptr<string> s(new string("move-only"));
+    cout << pool.submit([](unique_ptr<string> p) { return *p; },
+                        std::move(s)).get() << endl;
+
+    future<void> f2 = pool.submit([] { throw runtime_error("from a task"); });
+    try {
+        f2.get();
+    } catch (const exception& e) {
+        cout << "caught: " << e.what() << endl;
+    }
+
+    /////////////////////////////////////////////////////////
+    const size_t n = 1 << 24;
+    vector<int> data(n);
+    for (size_t i = 0; i < n; ++i)
+        data[i] = int(i);
+    vector<vec3> va(n / 4, vec3{1, 2, 3}), vb(n / 4, vec3{4, 5, 6}), vc(n / 4);
+
+    vector<unsigned> counts;
+    unsigned hw = thread::hardware_concurrency() ? thread::hardware_concurrency() : 1;
+    for (unsigned t = 1; t < hw; t *= 2)
+        counts.push_back(t);
+    counts.push_back(hw);
+
+    cout << setw(8) << "threads" << setw(14) << "reduce ms" << setw(10) << "speedup"
+         << setw(14) << "vec add ms" << setw(10) << "speedup" << endl;
+    double base_reduce = 0, base_add = 0;
+    uint64_t expected = 0;
+    for (unsigned t : counts) {
+        thread_pool p(t);
+        uint64_t total = 0;
+        double t_reduce = time_ms([&] {
+            total = parallel_reduce<uint64_t>(p, 0, n, 1 << 14,
+                [&](size_t lo, size_t hi) {
+                    uint64_t s = 0;
+                    for (size_t i = lo; i < hi; ++i)
+                        s += mix(uint64_t(data[i]));
+                    return s;
+                },
+                [](uint64_t l, uint64_t r) { return l + r; });
+        });
+        double t_add = time_ms([&] {
+            for (int rep = 0; rep < 10; ++rep)
+                parallel_for(p, 0, va.size(), 1 << 12,
+                    [&](size_t i) { vc[i] = va[i] + vb[i]; });
+        });
+        if (t == 1) {
+            base_reduce = t_reduce;
+            base_add = t_add;
+            expected = total;
+        }
+        cout << setw(8) << t << fixed << setprecision(1)
+             << setw(14) << t_reduce << setw(9) << base_reduce / t_reduce << "x"
+             << setw(14) << t_add << setw(9) << base_add / t_add << "x"
+             << (total == expected ? "" : "  MISMATCH") << endl;
+    }
+}
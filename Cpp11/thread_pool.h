@@ -0,0 +1,426 @@
+//
+//  thread_pool.h
+//
+//  Created on 10/19/26.
+//  https://www.di.ens.fr/~zappa/readings/ppopp13.pdf
+//  http://en.cppreference.com/w/cpp/thread/future
+//
+//  Work-stealing thread pool. Each worker owns a Chase-Lev deque: it
+//  pushes and pops tasks at the bottom while idle workers steal from the
+//  top with a single compare-and-swap. Tasks submitted from outside the
+//  pool go through a shared injection queue.
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "indices.h"
+
+namespace thread_pool_detail {
+
+struct pool_task {
+    virtual ~pool_task() { }
+    virtual void run() = 0;
+};
+
+////////////////////////////////////////////////////////////
+// Chase-Lev deque of task pointers, after Le, Pop, Cohen and Zappa
+// Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models"
+class work_stealing_deque {
+public:
+    work_stealing_deque() : m_top(0), m_bottom(0) {
+        m_arrays.emplace_back(new ring(64));
+        m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    // owner only
+    void push(pool_task* t) {
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t top = m_top.load(std::memory_order_acquire);
+        ring* a = m_array.load(std::memory_order_relaxed);
+        if (b - top > int64_t(a->size) - 1)
+            a = grow(a, top, b);
+        a->put(b, t);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // owner only
+    pool_task* pop() {
+        int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        ring* a = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+        if (t > b) {
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        pool_task* x = a->get(b);
+        if (t == b) {
+            // last element: race the thieves for it
+            if (!m_top.compare_exchange_strong(t, t + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed))
+                x = nullptr;
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return x;
+    }
+
+    // any thread
+    pool_task* steal() {
+        int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = m_bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return nullptr;
+        ring* a = m_array.load(std::memory_order_acquire);
+        pool_task* x = a->get(t);
+        if (!m_top.compare_exchange_strong(t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return x;
+    }
+
+    bool empty() const {
+        return m_bottom.load(std::memory_order_relaxed) <=
+               m_top.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct ring {
+        explicit ring(size_t n) : size(n), slots(new std::atomic<pool_task*>[n]) { }
+        pool_task* get(int64_t i) const
+            { return slots[i & (size - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t i, pool_task* t)
+            { slots[i & (size - 1)].store(t, std::memory_order_relaxed); }
+        size_t size;
+        std::unique_ptr<std::atomic<pool_task*>[]> slots;
+    };
+
+    // Thieves may still be reading the old ring, so it is kept alive
+    // until the deque goes away.
+    ring* grow(ring* a, int64_t top, int64_t bottom) {
+        m_arrays.emplace_back(new ring(a->size * 2));
+        ring* bigger = m_arrays.back().get();
+        for (int64_t i = top; i < bottom; ++i)
+            bigger->put(i, a->get(i));
+        m_array.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(64) std::atomic<int64_t> m_top;
+    alignas(64) std::atomic<int64_t> m_bottom;
+    std::atomic<ring*> m_array;
+    std::vector<std::unique_ptr<ring>> m_arrays;
+};
+
+////////////////////////////////////////////////////////////
+// Calls f with the elements of a tuple (std::apply is C++17)
+template<typename F, typename Tuple, size_t... Is>
+auto apply_tuple(F& f, Tuple& args, indices<Is...>)
+    -> decltype(f(std::move(std::get<Is>(args))...)) {
+    return f(std::move(std::get<Is>(args))...);
+}
+
+template<typename R> struct promise_setter {
+    template<typename F>
+    static void run(std::promise<R>& p, F& f) { p.set_value(f()); }
+};
+
+template<> struct promise_setter<void> {
+    template<typename F>
+    static void run(std::promise<void>& p, F& f) { f(); p.set_value(); }
+};
+
+// Owns the callable and decayed copies of its arguments: rvalues are
+// moved in once and moved again into the call, lvalues are copied once,
+// as with std::thread.
+template<typename R, typename F, typename... Args>
+struct bound_task : pool_task {
+    template<typename G, typename... A>
+    bound_task(G&& g, A&&... a)
+        : f(std::forward<G>(g)), args(std::forward<A>(a)...) { }
+
+    void run() {
+        try {
+            auto call = [this]() -> R {
+                return apply_tuple(f, args,
+                    make_indices<sizeof...(Args)>());
+            };
+            promise_setter<R>::run(promise, call);
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+        }
+    }
+
+    std::promise<R> promise;
+    F f;
+    std::tuple<Args...> args;
+};
+
+} // namespace thread_pool_detail
+
+////////////////////////////////////////////////////////////
+class thread_pool {
+    typedef thread_pool_detail::pool_task pool_task;
+
+public:
+    explicit thread_pool(unsigned threads = std::thread::hardware_concurrency())
+        : m_queues(threads ? threads : 1), m_stop(false), m_epoch(0),
+          m_sleepers(0) {
+        for (unsigned i = 0; i < m_queues.size(); ++i)
+            m_threads.emplace_back(&thread_pool::worker_loop, this, i);
+    }
+
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_stop = true;
+        }
+        m_sleep_cv.notify_all();
+        for (auto& t : m_threads)
+            t.join();
+        // tasks that never ran still own promises; drop them
+        while (pool_task* t = take_injected())
+            delete t;
+        for (auto& q : m_queues)
+            while (pool_task* t = q.steal())
+                delete t;
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    size_t size() const { return m_threads.size(); }
+
+    template<typename F, typename... Args>
+    std::future<typename std::result_of<
+        typename std::decay<F>::type(typename std::decay<Args>::type...)>::type>
+    submit(F&& f, Args&&... args) {
+        typedef typename std::result_of<typename std::decay<F>::type(
+            typename std::decay<Args>::type...)>::type result_type;
+        typedef thread_pool_detail::bound_task<result_type,
+            typename std::decay<F>::type, typename std::decay<Args>::type...> task_type;
+        task_type* t = new task_type(std::forward<F>(f),
+                                     std::forward<Args>(args)...);
+        std::future<result_type> fut = t->promise.get_future();
+        schedule(t);
+        return fut;
+    }
+
+    // Runs one pending task if there is any; used to help while waiting.
+    bool run_pending() {
+        pool_task* t = find_task(current_index());
+        if (!t)
+            return false;
+        t->run();
+        delete t;
+        return true;
+    }
+
+    // Pushes to the calling worker's own deque, or to the injection queue
+    // from threads outside the pool.
+    void schedule(pool_task* t) {
+        int self = current_index();
+        if (self >= 0) {
+            m_queues[self].push(t);
+        } else {
+            std::lock_guard<std::mutex> lock(m_inject_mutex);
+            m_injected.push_back(t);
+        }
+        m_epoch.fetch_add(1);
+        if (m_sleepers.load() > 0) {
+            std::lock_guard<std::mutex> lock(m_sleep_mutex);
+            m_sleep_cv.notify_one();
+        }
+    }
+
+private:
+    struct worker_id {
+        thread_pool* pool;
+        int index;
+    };
+
+    static worker_id& current() {
+        static thread_local worker_id id = { nullptr, -1 };
+        return id;
+    }
+
+    int current_index() const {
+        return current().pool == this ? current().index : -1;
+    }
+
+    pool_task* take_injected() {
+        std::lock_guard<std::mutex> lock(m_inject_mutex);
+        if (m_injected.empty())
+            return nullptr;
+        pool_task* t = m_injected.front();
+        m_injected.pop_front();
+        return t;
+    }
+
+    pool_task* find_task(int self) {
+        if (self >= 0)
+            if (pool_task* t = m_queues[self].pop())
+                return t;
+        if (pool_task* t = take_injected())
+            return t;
+        // start at a random victim so thieves spread out
+        static thread_local std::minstd_rand rng(
+            std::hash<std::thread::id>()(std::this_thread::get_id()));
+        size_t n = m_queues.size();
+        size_t start = rng() % n;
+        for (size_t i = 0; i < n; ++i) {
+            size_t victim = (start + i) % n;
+            if (int(victim) != self)
+                if (pool_task* t = m_queues[victim].steal())
+                    return t;
+        }
+        return nullptr;
+    }
+
+    void worker_loop(int index) {
+        current().pool = this;
+        current().index = index;
+        while (true) {
+            uint64_t epoch = m_epoch.load();
+            if (pool_task* t = find_task(index)) {
+                t->run();
+                delete t;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_sleep_mutex);
+            if (m_stop)
+                return;
+            // schedule() bumps the epoch after publishing a task, so a task
+            // missed by the scan above shows up as a changed epoch here
+            m_sleepers.fetch_add(1);
+            m_sleep_cv.wait(lock, [&] {
+                return m_stop || m_epoch.load() != epoch;
+            });
+            m_sleepers.fetch_sub(1);
+        }
+    }
+
+    std::vector<thread_pool_detail::work_stealing_deque> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_inject_mutex;
+    std::deque<pool_task*> m_injected;
+
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_sleep_cv;
+    bool m_stop;
+    std::atomic<uint64_t> m_epoch;
+    std::atomic<int> m_sleepers;
+};
+
+////////////////////////////////////////////////////////////
+// Fork-join: spawned tasks count down a join counter, and wait() runs
+// other pool tasks instead of blocking until the counter reaches zero.
+class task_group {
+public:
+    explicit task_group(thread_pool& pool) : m_pool(pool), m_pending(0) { }
+    ~task_group() { wait_quietly(); }
+
+    template<typename F>
+    void spawn(F&& f) {
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        m_pool.schedule(new group_task<typename std::decay<F>::type>(
+            *this, std::forward<F>(f)));
+    }
+
+    // rethrows the first exception thrown by a spawned task
+    void wait() {
+        wait_quietly();
+        if (m_error) {
+            std::exception_ptr e = m_error;
+            m_error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+private:
+    template<typename F>
+    struct group_task : thread_pool_detail::pool_task {
+        template<typename G>
+        group_task(task_group& g, G&& fn) : group(g), f(std::forward<G>(fn)) { }
+        void run() {
+            try {
+                f();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(group.m_error_mutex);
+                if (!group.m_error)
+                    group.m_error = std::current_exception();
+            }
+            group.m_pending.fetch_sub(1, std::memory_order_release);
+        }
+        task_group& group;
+        F f;
+    };
+
+    void wait_quietly() {
+        while (m_pending.load(std::memory_order_acquire) != 0)
+            if (!m_pool.run_pending())
+                std::this_thread::yield();
+    }
+
+    thread_pool& m_pool;
+    std::atomic<int> m_pending;
+    std::mutex m_error_mutex;
+    std::exception_ptr m_error;
+};
+
+// Calls f(i) for i in [begin, end), splitting the range in halves down to
+// chunks of at most grain indices. A grain of 0 counts as 1: a single
+// index cannot be split.
+template<typename F>
+void parallel_for(thread_pool& pool, size_t begin, size_t end, size_t grain,
+                  const F& f) {
+    if (end - begin <= std::max<size_t>(grain, 1)) {
+        for (size_t i = begin; i < end; ++i)
+            f(i);
+        return;
+    }
+    size_t mid = begin + (end - begin) / 2;
+    task_group g(pool);
+    g.spawn([&] { parallel_for(pool, mid, end, grain, f); });
+    parallel_for(pool, begin, mid, grain, f);
+    g.wait();
+}
+
+// Reduces [begin, end) with leaf(lo, hi) on chunks of at most grain
+// indices and combine(left, right) on the way back up; a grain of 0
+// counts as 1, as for parallel_for.
+template<typename T, typename Leaf, typename Combine>
+T parallel_reduce(thread_pool& pool, size_t begin, size_t end, size_t grain,
+                  const Leaf& leaf, const Combine& combine) {
+    if (end - begin <= std::max<size_t>(grain, 1))
+        return leaf(begin, end);
+    size_t mid = begin + (end - begin) / 2;
+    T right;
+    task_group g(pool);
+    g.spawn([&] {
+        right = parallel_reduce<T>(pool, mid, end, grain, leaf, combine);
+    });
+    T left = parallel_reduce<T>(pool, begin, mid, grain, leaf, combine);
+    g.wait();
+    return combine(left, right);
+}
+
+#endif
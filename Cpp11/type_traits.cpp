@@ -8,19 +8,15 @@
 #include <string>
 #include <vector>
 #include <list>
+#include "big_integer.h"
+#include "integral_trait.h"
+#include "iterator_trait.h"
 
-using namespace std;
+#ifdef BENCH
+#include "bench.h"
+#endif
 
-template<typename T> struct integral_trait
-    { enum { is_integral = false, }; };
-template<> struct integral_trait<char>
-    { enum { is_integral = true, }; };
-template<> struct integral_trait<unsigned char>
-    { enum { is_integral = true, }; };
-template<> struct integral_trait<int>
-    { enum { is_integral = true, }; };
-template<> struct integral_trait<unsigned int>
-    { enum { is_integral = true, }; };
+using namespace std;
 
 template<typename T, typename Trait = integral_trait<T>>
 bool is_integral_number(T) {
@@ -28,30 +24,9 @@ bool is_integral_number(T) {
 }
 
 ////////////////////////////////////////////////////////////
-// My classes
-struct big_integer {
-    big_integer(const string&) { }
-};
-
-template<> struct integral_trait<big_integer>
-    { enum { is_integral = true, }; };
-
+// My classes: big_integer specializes integral_trait in big_integer.h
 
 ////////////////////////////////////////////////////////////
-template<typename T>
-struct iterator_trait {
-    typedef typename T::iterator iterator;
-    static iterator begin(T& c) { return c.begin(); }
-    static iterator end(T& c) { return c.end(); }
-};
-
-template<typename T, size_t N>
-struct iterator_trait<T[N]> {
-    typedef T* iterator;
-    static iterator begin(T arr[N]) { return arr; }
-    static iterator end(T arr[N]) { return arr + N; }
-};
-
 template<typename T, typename Trait = iterator_trait<T>>
 // use reference to keep array from decaying to pointer
 void print_each(T& container) {
@@ -61,11 +36,15 @@ void print_each(T& container) {
     cout << endl;
 }
 
+#ifndef BENCH
 int main()
 {
     cout << is_integral_number(123) << endl; // 1
     cout << is_integral_number(123.) << endl; // 0
     cout << is_integral_number(big_integer("123")) << endl; // 1
+    big_integer five("5");
+    five -= five;
+    cout << five << endl; // 0
     cout << is_integral_number("123") << endl; // 0
 
     /////////////////////////////////////////////////////////
@@ -79,3 +58,25 @@ int main()
     print_each(vec_f); // 5 6
     print_each(lst_d); // 7 8
 }
+#else
+int main(int argc, char* argv[])
+{
+    bench::suite suite("type_traits", argc, argv);
+
+    int arr_i[] = { 1, 2 };
+    string arr_s[] = { "3", "4" };
+    vector<float> vec_f = { 5.f, 6.f };
+    list<double> lst_d = { 7., 8. };
+
+    // measures the traversal and formatting, not the terminal
+    bench::null_buf null;
+    streambuf* old = cout.rdbuf(&null);
+    suite.run("print_each_array_int", [&] { print_each(arr_i); });
+    suite.run("print_each_array_string", [&] { print_each(arr_s); });
+    suite.run("print_each_vector_float", [&] { print_each(vec_f); });
+    suite.run("print_each_list_double", [&] { print_each(lst_d); });
+    cout.rdbuf(old);
+
+    return suite.finish();
+}
+#endif
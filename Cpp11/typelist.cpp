@@ -0,0 +1,469 @@
+//
+//  typelist.cpp
+//
+//  Created on 10/19/26.
+//  http://www.pdimov.com/cpp2/simple_cxx11_metaprogramming.html
+//  http://ldionne.com/2015/11/29/efficient-parameter-pack-indexing/
+//
+//  Non-recursive versions of the type list utilities in
+//  variadic_templates.cpp. Every operation is either a single pack
+//  expansion or a divide-and-conquer over index ranges, so the template
+//  instantiation depth is O(1) or O(log N) in the length of the list
+//  instead of one nested instantiation per element.
+
+#include <iostream>
+#include <typeinfo>
+#include <type_traits>
+#include <cstddef>
+#include "indices.h"
+
+template<class... Ts> struct type_list {
+    static const std::size_t size = sizeof...(Ts);
+};
+
+template<class T> struct identity {
+    typedef T type;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//Constant arrays and log-depth constexpr reductions over them
+///////////////////////////////////////////////////////////////////////////////
+// A trailing element keeps the array non-empty for empty packs.
+template<class T, T... Vs> struct value_array {
+    static constexpr T value[sizeof...(Vs) + 1] = { Vs..., T() };
+};
+
+template<class T, T... Vs>
+constexpr T value_array<T, Vs...>::value[];
+
+template<bool... Bs> struct bool_array : value_array<bool, Bs...> { };
+
+template<bool...> struct bool_pack;
+
+// All bits are set iff shifting the pack by one leaves it unchanged.
+template<bool... Bs> struct all_of
+    : std::is_same<bool_pack<true, Bs...>, bool_pack<Bs..., true>> { };
+
+// Both reductions split [lo, hi) at the same midpoints, so the compiler's
+// constexpr call cache shares the sub-results between queries.
+template<class R, class T>
+constexpr R sum_range(const T* v, std::size_t lo, std::size_t hi)
+{
+    return hi - lo == 0 ? R() :
+           hi - lo == 1 ? R(v[lo]) :
+           sum_range<R>(v, lo, lo + (hi - lo) / 2) +
+           sum_range<R>(v, lo + (hi - lo) / 2, hi);
+}
+
+constexpr std::size_t first_found(std::size_t left, std::size_t mid,
+                                  std::size_t right)
+{
+    return left != mid ? left : right;
+}
+
+// Index of the first true element in [lo, hi), or hi if there is none.
+constexpr std::size_t find_true(const bool* b, std::size_t lo, std::size_t hi)
+{
+    return hi - lo == 0 ? hi :
+           hi - lo == 1 ? (b[lo] ? lo : hi) :
+           first_found(find_true(b, lo, lo + (hi - lo) / 2),
+                       lo + (hi - lo) / 2,
+                       find_true(b, lo + (hi - lo) / 2, hi));
+}
+
+// Index of the n-th (0-based) true element in [lo, hi).
+constexpr std::size_t nth_true(const bool* b, std::size_t lo, std::size_t hi,
+                               std::size_t n)
+{
+    return hi - lo <= 1 ? lo :
+           n < sum_range<std::size_t>(b, lo, lo + (hi - lo) / 2) ?
+               nth_true(b, lo, lo + (hi - lo) / 2, n) :
+               nth_true(b, lo + (hi - lo) / 2, hi,
+                        n - sum_range<std::size_t>(b, lo, lo + (hi - lo) / 2));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//Indexing: at<I, List> by overload resolution against indexed bases
+///////////////////////////////////////////////////////////////////////////////
+template<std::size_t I, class T> struct indexed { };
+
+template<class Seq, class... Ts> struct indexer;
+
+template<std::size_t... Is, class... Ts>
+struct indexer<indices<Is...>, Ts...> : indexed<Is, Ts>... { };
+
+template<std::size_t I, class T>
+identity<T> select_indexed(const indexed<I, T>*);
+
+template<std::size_t I, class List> struct at;
+
+template<std::size_t I, class... Ts>
+struct at<I, type_list<Ts...>>
+    : decltype(select_indexed<I>(static_cast<
+          indexer<typename make_indices<sizeof...(Ts)>::type, Ts...>*
+      >(nullptr))) { };
+
+// Keeps the elements whose mask bit is set, in order.
+template<class List, class Mask, class Seq> struct select_by_mask;
+
+template<class... Ts, bool... Bs, std::size_t... Js>
+struct select_by_mask<type_list<Ts...>, bool_array<Bs...>,
+                      indices<Js...>> {
+    typedef type_list<typename at<
+        nth_true(bool_array<Bs...>::value, 0, sizeof...(Bs), Js),
+        type_list<Ts...>>::type...> type;
+};
+
+// A full mask selects the list itself; skip the per-element lookups.
+template<class List, bool Full, bool... Bs> struct select_mask_impl
+    : select_by_mask<List, bool_array<Bs...>, typename make_indices<
+          sum_range<std::size_t>(bool_array<Bs...>::value, 0, sizeof...(Bs))
+      >::type> { };
+
+template<class List, bool... Bs> struct select_mask_impl<List, true, Bs...> {
+    typedef List type;
+};
+
+template<class List, bool... Bs> struct select_mask
+    : select_mask_impl<List, all_of<Bs...>::value, Bs...> { };
+
+// Feeds the elements of a list to a variadic template: apply<count, L>.
+template<template<class...> class F, class List> struct apply;
+
+template<template<class...> class F, class... Ts>
+struct apply<F, type_list<Ts...>> : F<Ts...> { };
+
+///////////////////////////////////////////////////////////////////////////////
+//Lists
+///////////////////////////////////////////////////////////////////////////////
+template<class... list> struct
+count {
+    static const int value = sizeof...(list);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//Higher-Order Functions and Closures
+///////////////////////////////////////////////////////////////////////////////
+template<class T> struct
+isPtr {
+    static const bool value = false;
+};
+
+template<class U> struct
+isPtr<U*> {
+    static const bool value = true;
+};
+
+template<class U> struct
+isPtr<U * const> {
+    static const bool value = true;
+};
+
+template<class T> struct
+isConst {
+    static const bool value = false;
+};
+
+template<class T> struct
+isConst<const T> {
+    static const bool value = true;
+};
+
+template<template<class> class f1, template<class> class f2> struct
+or_combinator {
+    template<class T> struct
+    lambda {
+        static const bool value = f1<T>::value || f2<T>::value;
+    };
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//Higher-Order Functions Operating on Lists
+///////////////////////////////////////////////////////////////////////////////
+template<template<class> class predicate, class... list> struct
+all {
+    static const bool value = all_of<predicate<list>::value...>::value;
+};
+
+template<class T, int u> struct add
+{
+  static const int value = 1 + u;
+};
+
+// Folds [Lo, Hi) by folding the right half first and feeding its result
+// to the left half, so the nesting depth is log2(Hi - Lo).
+template<template<class, int> class f, int init, class List,
+         std::size_t Lo, std::size_t Hi, std::size_t N = Hi - Lo> struct
+fold_range {
+    static const std::size_t mid = Lo + N / 2;
+    static const int value = fold_range<
+        f, fold_range<f, init, List, mid, Hi>::value, List, Lo, mid>::value;
+};
+
+template<template<class, int> class f, int init, class List,
+         std::size_t Lo, std::size_t Hi> struct
+fold_range<f, init, List, Lo, Hi, 0> {
+    static const int value = init;
+};
+
+template<template<class, int> class f, int init, class List,
+         std::size_t Lo, std::size_t Hi> struct
+fold_range<f, init, List, Lo, Hi, 1> {
+    static const int value = f<typename at<Lo, List>::type, init>::value;
+};
+
+template<template<class, int> class f, int init, class... list> struct
+fold_right {
+    static const int value =
+        fold_range<f, init, type_list<list...>, 0, sizeof...(list)>::value;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//List of Numbers
+///////////////////////////////////////////////////////////////////////////////
+template<int... list> struct
+sum {
+    static const int value = sum_range<int>(
+        value_array<int, list...>::value, 0, sizeof...(list));
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//List Comprehension
+///////////////////////////////////////////////////////////////////////////////
+template<class T> struct
+one {
+    static const int value = 1;
+};
+
+template<class... lst> struct
+counter {
+    static const int value = sum<one<lst>::value...>::value;
+};
+
+template<class... lst> struct
+countPtrs {
+    static const int value = sum<isPtr<lst>::value ...>::value;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//Continuations
+///////////////////////////////////////////////////////////////////////////////
+template<typename T> struct
+fun {
+  typedef T type;
+};
+
+template<template<class...> class counter,
+         template<class> class f,
+         class... lst> struct
+map_cont {
+    static const int value =
+        counter<typename f<lst>::type ...>::value;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//Searching and reshaping lists
+///////////////////////////////////////////////////////////////////////////////
+// Position of the first element satisfying predicate, or List::size.
+template<template<class> class predicate, class List> struct find;
+
+template<template<class> class predicate, class... Ts>
+struct find<predicate, type_list<Ts...>> {
+    static const std::size_t value = find_true(
+        bool_array<predicate<Ts>::value...>::value, 0, sizeof...(Ts));
+};
+
+template<class T> struct void_type {
+    typedef void type;
+};
+
+// Deduction of I fails when T occurs more than once (or not at all), so
+// only then do we fall back to comparing T against every element.
+template<class T, std::size_t I>
+std::integral_constant<std::size_t, I> sole_index(const indexed<I, T>*);
+
+template<class T, class List> struct scan_index_of;
+
+template<class T, class... Ts>
+struct scan_index_of<T, type_list<Ts...>> {
+    static const std::size_t value = find_true(
+        bool_array<std::is_same<T, Ts>::value...>::value, 0, sizeof...(Ts));
+};
+
+template<class T, class Indexer>
+auto try_sole_index(int)
+    -> decltype(sole_index<T>(static_cast<Indexer*>(nullptr)));
+
+template<class T, class Indexer>
+std::false_type try_sole_index(...);
+
+template<class T, class List, class Indexer,
+         class Sole = decltype(try_sole_index<T, Indexer>(0))>
+struct index_of_impl : Sole { };
+
+template<class T, class List, class Indexer>
+struct index_of_impl<T, List, Indexer, std::false_type>
+    : scan_index_of<T, List> { };
+
+template<class T, class List> struct index_of;
+
+template<class T, class... Ts>
+struct index_of<T, type_list<Ts...>> : index_of_impl<T, type_list<Ts...>,
+    indexer<typename make_indices<sizeof...(Ts)>::type, Ts...>> { };
+
+template<template<class> class f, class List> struct transform;
+
+template<template<class> class f, class... Ts>
+struct transform<f, type_list<Ts...>> {
+    typedef type_list<typename f<Ts>::type...> type;
+};
+
+template<template<class> class predicate, class List> struct filter;
+
+template<template<class> class predicate, class... Ts>
+struct filter<predicate, type_list<Ts...>>
+    : select_mask<type_list<Ts...>, predicate<Ts>::value...> { };
+
+// Keeps an element iff it is the first occurrence of its type.
+template<class List, class Seq = typename make_indices<List::size>::type>
+struct unique;
+
+template<class... Ts, std::size_t... Is>
+struct unique<type_list<Ts...>, indices<Is...>>
+    : select_mask<type_list<Ts...>,
+                  index_of<Ts, type_list<Ts...>>::value == Is...> { };
+
+///////////////////////////////////////////////////////////////////////////////
+//Compile-time benchmark, built by typelist_ctbench with
+//  -DTYPELIST_BENCH_SIZE=<N> -DTYPELIST_BENCH_MODE=<0|1|2>
+//  0: the recursive originals from variadic_templates.cpp
+//  1: the same operations from this file
+//  2: find, filter, unique, index_of and transform from this file
+///////////////////////////////////////////////////////////////////////////////
+#ifdef TYPELIST_BENCH_SIZE
+namespace bench {
+
+template<std::size_t I> struct t { };
+
+template<class Seq> struct make_list;
+template<std::size_t... Is> struct make_list<indices<Is...>> {
+    typedef type_list<t<Is>*...> type;
+};
+
+const std::size_t N = TYPELIST_BENCH_SIZE;
+typedef make_list<make_indices<N>::type>::type list;
+
+template<class T> struct is_last : std::is_same<T, t<N - 1>*> { };
+template<class T> struct is_even_ptr;
+template<std::size_t I> struct is_even_ptr<t<I>*> {
+    static const bool value = I % 2 == 0;
+};
+template<class T> struct add_const_ptr { typedef T const type; };
+
+template<template<int...> class F, class List> struct apply_ones;
+template<template<int...> class F, class... Ts>
+struct apply_ones<F, type_list<Ts...>> : F<one<Ts>::value...> { };
+
+#if TYPELIST_BENCH_MODE == 0
+namespace recursive {
+
+template<class... list> struct count;
+template<> struct count<> { static const int value = 0; };
+template<class head, class... tail> struct count<head, tail...> {
+    static const int value = 1 + count<tail...>::value;
+};
+
+template<template<class> class predicate, class... list> struct all;
+template<template<class> class predicate> struct all<predicate> {
+    static const bool value = true;
+};
+template<template<class> class predicate, class head, class... tail>
+struct all<predicate, head, tail...> {
+    static const bool value =
+        predicate<head>::value && all<predicate, tail...>::value;
+};
+
+template<template<class, int> class, int, class...> struct fold_right;
+template<template<class, int> class f, int init>
+struct fold_right<f, init> { static const int value = init; };
+template<template<class, int> class f, int init, class head, class... tail>
+struct fold_right<f, init, head, tail...> {
+    static const int value =
+        f<head, fold_right<f, init, tail...>::value>::value;
+};
+
+template<int...> struct sum;
+template<> struct sum<> { static const int value = 0; };
+template<int i, int... tail> struct sum<i, tail...> {
+    static const int value = i + sum<tail...>::value;
+};
+
+template<class... lst> struct counter {
+    static const int value = sum<one<lst>::value...>::value;
+};
+template<class... lst> struct countPtrs {
+    static const int value = sum<isPtr<lst>::value...>::value;
+};
+
+} // namespace recursive
+using namespace recursive;
+#endif
+
+#if TYPELIST_BENCH_MODE == 0 || TYPELIST_BENCH_MODE == 1
+template<class... Ts> struct all_ptrs : all<isPtr, Ts...> { };
+template<class... Ts> struct fold_add : fold_right<add, 0, Ts...> { };
+
+static_assert(apply<count, list>::value == int(N), "count");
+static_assert(apply<all_ptrs, list>::value, "all");
+static_assert(apply<fold_add, list>::value == int(N), "fold_right");
+static_assert(apply_ones<sum, list>::value == int(N), "sum");
+static_assert(apply<counter, list>::value == int(N), "counter");
+static_assert(apply<countPtrs, list>::value == int(N), "countPtrs");
+#elif TYPELIST_BENCH_MODE == 2
+static_assert(find<is_last, list>::value == N - 1, "find");
+static_assert(index_of<t<N / 2>*, list>::value == N / 2, "index_of");
+static_assert(filter<is_even_ptr, list>::type::size == (N + 1) / 2, "filter");
+static_assert(std::is_same<unique<list>::type, list>::value, "unique");
+static_assert(transform<add_const_ptr, list>::type::size == N, "transform");
+#endif
+
+} // namespace bench
+#endif
+
+int main()
+{
+  typedef type_list<int, char*, long, char*, double> l;
+
+  std::cout << "count<int, char, long>::value = " << count<int, char, long>::value << std::endl;
+
+  std::cout << "or_combinator<isPtr, isConst>::lambda<const int>::value = "
+            << or_combinator<isPtr, isConst>::lambda<const int>::value
+            << std::endl;
+
+  std::cout << "all<isPtr>::value = " << all<isPtr, int*, char*, long>::value << std::endl;
+  std::cout << "all<isPtr>::value = " << all<isPtr, int*, char*, long*>::value << std::endl;
+
+  std::cout << "Fold right = " << fold_right<add, 3, int, double, char>::value << std::endl;
+
+  std::cout << "sum<1, 2, 3, 4>::value = " << sum<1, 2, 3, 4>::value << std::endl;
+  std::cout << "counter<int, char, long>::value = " << counter<int, char, long>::value << std::endl;
+  std::cout << "countPtrs<int*, char, long*>::value = " << countPtrs<int*, char, long*>::value << std::endl;
+  std::cout << "map_cont<counter, fun, int, char, long, double>::value = "
+            << map_cont<counter, fun, int, char, long, double>::value << std::endl;
+
+  /////////////////////////////////////////////////////////////////////////////
+  std::cout << "find<isPtr, l>::value = " << find<isPtr, l>::value << std::endl; // 1
+  std::cout << "index_of<double, l>::value = " << index_of<double, l>::value << std::endl; // 4
+  std::cout << "at<2, l>::type = " << typeid(at<2, l>::type).name() << std::endl;
+  std::cout << "filter<isPtr, l>::type::size = " << filter<isPtr, l>::type::size << std::endl; // 2
+  std::cout << "unique<l>::type::size = " << unique<l>::type::size << std::endl; // 4
+  std::cout << "apply<count, transform<fun, l>::type>::value = "
+            << apply<count, transform<fun, l>::type>::value << std::endl; // 5
+
+  static_assert(std::is_same<unique<l>::type,
+                             type_list<int, char*, long, double>>::value, "");
+  static_assert(std::is_same<filter<isPtr, l>::type,
+                             type_list<char*, char*>>::value, "");
+
+  return 0;
+}
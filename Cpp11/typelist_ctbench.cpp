@@ -0,0 +1,105 @@
+//
+//  typelist_ctbench.cpp
+//
+//  Created on 10/19/26.
+//  http://man7.org/linux/man-pages/man2/wait4.2.html
+//
+//  Compile-time benchmark for typelist.cpp: compiles the benchmark section
+//  for lists of 10, 100 and 1000 types and reports the wall time and peak
+//  memory of each compiler run.
+//
+//  usage: typelist_ctbench <compiler> <typelist.cpp>
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+struct compile_result {
+    bool ok;
+    double seconds;
+    long max_rss_kb;
+};
+
+compile_result compile(const std::vector<std::string>& args)
+{
+    std::vector<char*> argv;
+    for (const auto& a : args)
+        argv.push_back(const_cast<char*>(a.c_str()));
+    argv.push_back(nullptr);
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        // keep the table readable: diagnostics only matter as a failure
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, STDERR_FILENO);
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+
+    int status = 0;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    compile_result r;
+    r.ok = pid > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    r.seconds = elapsed.count();
+    r.max_rss_kb = usage.ru_maxrss;
+    return r;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <compiler> <typelist.cpp>\n";
+        return 1;
+    }
+
+    const char* modes[] = {
+        "recursive (variadic_templates.cpp)",
+        "pack expansion (typelist.cpp)",
+        "find/filter/unique/index_of/transform",
+    };
+    const int sizes[] = { 10, 100, 1000 };
+
+    std::cout << std::left << std::setw(40) << "operations"
+              << std::right << std::setw(6) << "N"
+              << std::setw(10) << "time(s)"
+              << std::setw(12) << "RSS(MB)" << '\n';
+
+    bool all_ok = true;
+    for (int mode = 0; mode < 3; ++mode) {
+        for (int n : sizes) {
+            std::vector<std::string> args = {
+                argv[1], "-std=c++11", "-fsyntax-only",
+                "-DTYPELIST_BENCH_SIZE=" + std::to_string(n),
+                "-DTYPELIST_BENCH_MODE=" + std::to_string(mode),
+            };
+            // the recursive versions nest one instantiation per element
+            // and would otherwise hit the default limit of 900
+            if (mode == 0)
+                args.push_back("-ftemplate-depth=" + std::to_string(4 * n + 100));
+            args.push_back(argv[2]);
+
+            compile_result r = compile(args);
+            all_ok = all_ok && r.ok;
+            std::cout << std::left << std::setw(40) << modes[mode]
+                      << std::right << std::setw(6) << n
+                      << std::setw(10) << std::fixed << std::setprecision(2)
+                      << r.seconds
+                      << std::setw(12) << std::setprecision(1)
+                      << r.max_rss_kb / 1024.0
+                      << (r.ok ? "" : "  FAILED") << std::endl;
+        }
+    }
+    return all_ok ? 0 : 1;
+}
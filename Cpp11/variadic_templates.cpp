@@ -11,6 +11,13 @@
 #include <list>
 #include <map>
 #include <memory>
+#include "format.h"
+#include "flat_map.h"
+#include "inplace_function.h"
+
+#ifdef BENCH
+#include "bench.h"
+#endif
 
 ///////////////////////////////////////////////////////////////////////////////
 //Basic example
@@ -135,6 +142,23 @@ void print_container(const ContainerType<ValueType, Args...>& c) {
   std::cout << '\n';
 }
 
+// The same output through formats compiled by format.h, appended to a
+// buffer that is reused from line to line.
+template <typename T, typename U>
+void format_value(format_buffer& out, const std::pair<T, U>& p) {
+  format_to(out, FMT("[{}, {}]"), p.first, p.second);
+}
+
+template <template <typename, typename...> class ContainerType,
+          typename ValueType, typename... Args>
+void format_container(format_buffer& out,
+                      const ContainerType<ValueType, Args...>& c) {
+  for (const auto& v : c) {
+    format_to(out, FMT("{} "), v);
+  }
+  out.push_back('\n');
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //Variadic templates for forwarding
 //http://en.cppreference.com/w/cpp/memory/unique_ptr/make_unique
@@ -159,6 +183,9 @@ struct Vec3
     friend std::ostream& operator<<(std::ostream& os, Vec3& v) {
         return os << '{' << "x:" << v.x << " y:" << v.y << " z:" << v.z  << '}';
     }
+    friend void format_value(format_buffer& out, const Vec3& v) {
+        format_to(out, FMT("{{x:{x:} y:{y:} z:{z:}}}"), v.x, v.y, v.z);
+    }
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -311,6 +338,26 @@ int map_cont_run(int (*cont)(std::list<T> list), int (*f)(T), const std::list<T>
     return cont(tmp);
 }
 
+// The same with callables that may carry state, stored inline. T is
+// deduced from lst only, so lambdas convert without naming the type.
+template<typename T> struct
+non_deduced {
+  typedef T type;
+};
+
+template<typename T>
+int map_cont_run(typename non_deduced<inplace_function<int(std::list<T>)>>::type cont,
+                 typename non_deduced<inplace_function<int(T)>>::type f,
+                 const std::list<T> &lst) {
+    std::list<T> tmp;
+    for (auto it = lst.begin(); it != lst.end(); ++it)
+        tmp.push_front(f(*it));
+    return cont(tmp);
+}
+
+int list_size(std::list<int> l) { return int(l.size()); }
+int square(int i) { return i * i; }
+
 template<typename T> struct
 fun {
   typedef T type;
@@ -327,6 +374,7 @@ map_cont {
 ///////////////////////////////////////////////////////////////////////////////
 //mailist<T> n
 ///////////////////////////////////////////////////////////////////////////////
+#ifndef BENCH
 int main()
 {
   long lsum = adder(1, 2, 3, 8, 7);
@@ -383,6 +431,15 @@ int main()
   std::map<std::string, int> msi{{"foo", 42}, {"bar", 81}, {"bazzo", 4}};
   print_container(msi);
 
+  // the same entries in sorted arrays, printed the same way
+  flat_map<std::string, int> fsi{{"foo", 42}, {"bar", 81}, {"bazzo", 4}};
+  print_container(fsi);
+
+  format_buffer buf;
+  format_container(buf, vd);
+  format_container(buf, msi);
+  std::cout << buf; // the same two lines again
+
   /////////////////////////////////////////////////////////////////////////////
   // http://en.cppreference.com/w/cpp/memory/unique_ptr/make_unique
   // Use the default constructor.
@@ -394,6 +451,7 @@ int main()
 
   std::cout << "make_unique<Vec3>():      " << *v1 << '\n'
             << "make_unique<Vec3>(0,1,2): " << *v2 << '\n';
+  std::cout << format(FMT("formatted:                {}\n"), *v2);
   //          << "make_unique<Vec3[]>(5):   " << '\n';
   //for (int i = 0; i < 5; i++) {
   //    std::cout << "     " << v3[i] << '\n';
@@ -423,5 +481,116 @@ int main()
   std::cout << "map_cont<counter, fun, int, char, long, double>::value = "
             << map_cont<counter, fun, int, char, long, double>::value << std::endl;
 
+  std::list<int> nums{1, 2, 3, 4};
+  int offset = 10;
+  std::cout << "map_cont_run(list_size, square, nums) = "
+            << map_cont_run(list_size, square, nums) << std::endl; // 4
+  std::cout << "map_cont_run(sum, + offset, nums) = "
+            << map_cont_run<int>([](std::list<int> l) {
+                 int s = 0;
+                 for (int i : l) s += i;
+                 return s;
+               }, [offset](int i) { return i + offset; }, nums) << std::endl; // 50
+  inplace_function<void(int)> show([](int i) {std::cout << i << " ";});
+  expand_with_forward(show, 8,7,6,5);
+
   return 0;
 }
+#else
+int main(int argc, char* argv[])
+{
+  bench::suite suite("variadic_templates", argc, argv);
+
+  tuple<double, uint64_t, const char*> t1(12.2, 42, "big");
+  suite.run("tuple_get", [&] {
+    bench::do_not_optimize(t1);
+    bench::do_not_optimize(get<0>(t1) + get<1>(t1));
+  });
+
+  int a = 1, b = 2, c = 3, d = 8, e = 7;
+  suite.run("adder_int", [&] {
+    bench::do_not_optimize(a);
+    bench::do_not_optimize(adder(a, b, c, d, e));
+  });
+
+  std::string s1 = "x", s2 = "aa", s3 = "bb", s4 = "yy";
+  suite.run("adder_string", [&] {
+    bench::do_not_optimize(adder(s1, s2, s3, s4));
+  });
+
+  // continuations through function pointers, std::function and
+  // inplace_function, with a captured offset for the last two
+  std::list<int> nums{1, 2, 3, 4, 5, 6, 7, 8};
+  int offset = 3;
+  suite.run("map_cont_run_pointer", [&] {
+    bench::do_not_optimize(map_cont_run(list_size, square, nums));
+  });
+  suite.run("call_std_function", [&] {
+    std::function<int(int)> f([offset](int i) { return i + offset; });
+    bench::do_not_optimize(f);
+    bench::do_not_optimize(f(4));
+  });
+  suite.run("call_inplace_function", [&] {
+    inplace_function<int(int)> f([offset](int i) { return i + offset; });
+    bench::do_not_optimize(f);
+    bench::do_not_optimize(f(4));
+  });
+  suite.run("map_cont_run_inplace", [&] {
+    bench::do_not_optimize(map_cont_run<int>(list_size,
+        [offset](int i) { return i + offset; }, nums));
+  });
+
+  // log lines: chains of ostream << into a discarding stream buffer,
+  // against compiled formats into a reused buffer
+  bench::null_buf null;
+  std::streambuf* old = std::cout.rdbuf(&null);
+  format_buffer buf;
+
+  std::map<std::string, int> msi{{"foo", 42}, {"bar", 81}, {"bazzo", 4}};
+  suite.run("print_container_map_ostream", [&] { print_container(msi); });
+  suite.run("print_container_map_format", [&] {
+    buf.clear();
+    format_container(buf, msi);
+    bench::do_not_optimize(buf.data());
+  });
+
+  flat_map<std::string, int> fsi(msi.begin(), msi.end());
+  suite.run("print_container_flat_format", [&] {
+    buf.clear();
+    format_container(buf, fsi);
+    bench::do_not_optimize(buf.data());
+  });
+  std::string key = "bazzo";
+  suite.run("find_map", [&] {
+    bench::do_not_optimize(key);
+    bench::do_not_optimize(msi.find(key)->second);
+  });
+  suite.run("find_flat_map", [&] {
+    bench::do_not_optimize(key);
+    bench::do_not_optimize(fsi.find(key)->second);
+  });
+
+  Vec3 v(0, 1, 2);
+  suite.run("vec3_ostream", [&] { std::cout << v << '\n'; });
+  suite.run("vec3_format", [&] {
+    buf.clear();
+    format_to(buf, FMT("{}\n"), v);
+    bench::do_not_optimize(buf.data());
+  });
+
+  long id = 1234567;
+  std::string level = "warn", what = "flush";
+  double ms = 12.75;
+  suite.run("log_line_ostream", [&] {
+    std::cout << id << " [" << level << "] " << what << " took " << ms << "ms\n";
+  });
+  suite.run("log_line_format", [&] {
+    buf.clear();
+    format_to(buf, FMT("{} [{}] {} took {}ms\n"), id, level, what, ms);
+    bench::do_not_optimize(buf.data());
+  });
+  std::cout.rdbuf(old);
+
+  return suite.finish();
+}
+#endif